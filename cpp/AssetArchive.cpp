@@ -0,0 +1,111 @@
+//
+// Created by cjf12 on 2019-11-19.
+//
+
+#include "include/AssetArchive.h"
+#include "include/Log.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+AssetArchive::AssetArchive() :
+        mDescriptor(-1),
+        mBuffer(NULL), mLength(0),
+        mEntries(NULL), mEntryCount(0) {
+}
+
+AssetArchive::~AssetArchive() {
+    close();
+}
+
+status AssetArchive::open(const char *pPath) {
+    close();
+    struct stat filestatus;
+    const AssetArchiveHeader *header;
+    uint64_t indexEnd;
+    void *buffer;
+
+    mDescriptor = ::open(pPath, O_RDONLY);
+    if (mDescriptor < 0) return STATUS_KO;
+    if (fstat(mDescriptor, &filestatus) < 0) goto ERROR;
+    if (filestatus.st_size < (off_t) sizeof(AssetArchiveHeader)) goto ERROR;
+    buffer = mmap(NULL, filestatus.st_size, PROT_READ, MAP_PRIVATE, mDescriptor, 0);
+    if (buffer == MAP_FAILED) goto ERROR;
+    mBuffer = (const uint8_t *) buffer;
+    mLength = filestatus.st_size;
+
+    //Checks the header and that every entry lies within the file, so
+    //that lookups need no further validation. A byte-swapped archive
+    //fails the magic.
+    header = (const AssetArchiveHeader *) mBuffer;
+    if ((header->magic != ASSET_ARCHIVE_MAGIC)
+        || (header->version != ASSET_ARCHIVE_VERSION)) goto ERROR;
+    indexEnd = sizeof(AssetArchiveHeader)
+               + uint64_t(header->entryCount) * sizeof(AssetArchiveEntry);
+    if (indexEnd > uint64_t(mLength)) goto ERROR;
+    mEntries = (const AssetArchiveEntry *) (mBuffer + sizeof(AssetArchiveHeader));
+    mEntryCount = header->entryCount;
+    for (uint32_t i = 0; i < mEntryCount; ++i) {
+        const AssetArchiveEntry &entry = mEntries[i];
+        if ((i > 0) && (mEntries[i - 1].hash > entry.hash)) goto ERROR;
+        if ((entry.offset > uint64_t(mLength))
+            || (entry.size > uint64_t(mLength) - entry.offset)) goto ERROR;
+        if ((entry.pathOffset < indexEnd) || (entry.pathOffset >= uint64_t(mLength))
+            || (memchr(mBuffer + entry.pathOffset, '\0', mLength - entry.pathOffset) == NULL))
+            goto ERROR;
+        if (!(entry.flags & ASSET_ARCHIVE_DEFLATED) && (entry.size != entry.length)) goto ERROR;
+    }
+    Log::info("Opened asset archive %s (%d entries)", pPath, mEntryCount);
+    return STATUS_OK;
+
+    ERROR:
+    Log::error("Invalid asset archive %s", pPath);
+    close();
+    return STATUS_KO;
+}
+
+void AssetArchive::close() {
+    if (mBuffer != NULL) {
+        munmap((void *) mBuffer, mLength);
+        mBuffer = NULL;
+        mLength = 0;
+    }
+    if (mDescriptor >= 0) {
+        ::close(mDescriptor);
+        mDescriptor = -1;
+    }
+    mEntries = NULL;
+    mEntryCount = 0;
+}
+
+const AssetArchiveEntry *AssetArchive::find(const char *pPath) {
+    uint64_t hash = hashPath(pPath);
+    //Lower bound on the hash, then compares paths in case of collisions.
+    uint32_t first = 0, count = mEntryCount;
+    while (count > 0) {
+        uint32_t step = count / 2;
+        if (mEntries[first + step].hash < hash) {
+            first += step + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    for (; (first < mEntryCount) && (mEntries[first].hash == hash); ++first) {
+        if (strcmp((const char *) mBuffer + mEntries[first].pathOffset, pPath) == 0) {
+            return &mEntries[first];
+        }
+    }
+    return NULL;
+}
+
+uint64_t AssetArchive::hashPath(const char *pPath) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const uint8_t *c = (const uint8_t *) pPath; *c != '\0'; ++c) {
+        hash = (hash ^ *c) * 0x100000001b3ULL;
+    }
+    return hash;
+}
@@ -10,22 +10,46 @@ static const float MIN_VELOCITY = 30.0f/PHYSICS_SCALE;
 static const float VELOCITY_RANGE = 60.0f/PHYSICS_SCALE;
 
 
+//Random numbers drawn in one go, three per respawn.
+static const int32_t RANDOM_STREAM_SIZE = 1024;
+//Random stream of the asteroids, see Random.
+static const uint32_t RANDOM_STREAM = 2;
+
 Asteroid::Asteroid(android_app *pApplication,
                    TimeManager &mTImeManager,
                    GraphicsManager &mGraphicsManager,
-                   PhysicsManager &mPhysicsManager) :
+                   PhysicsManager &mPhysicsManager,
+                   bool pKinematic, uint64_t pSeed) :
         mTImeManager(mTImeManager),
         mGraphicsManager(mGraphicsManager),
         mPhysicsManager(mPhysicsManager),
-        mBodies(),
+        mKinematic(pKinematic),
+        mBodies(), mKinematicBodies(),
+        mSlots(), mOutOfBounds(),
+        mRandom(pSeed, RANDOM_STREAM),
+        mRandomStream(RANDOM_STREAM_SIZE), mRandomCursor(RANDOM_STREAM_SIZE),
         mMinBound(0.0f),
         mUpperBound(0.0f), mLowerBound(0.0f),
         mLeftBound(0.0f), mRightBound(0.0f) {
 }
 
-void Asteroid::registerAsteroid(Location &pLocation, int32_t pSizeX, int32_t pSizeY) {
-    //Asteroid is a b2Body with cat1, and only collide with cat 2 objects
-    mBodies.push_back(mPhysicsManager.loadBody(pLocation, 0x1, 0x2, pSizeX, pSizeY, 2.0f));
+void Asteroid::registerAsteroid(Sprite *pGraphics, int32_t pSizeX, int32_t pSizeY) {
+    int32_t slot;
+    if (mKinematic) {
+        //Same filter, but only detects overlaps instead of bouncing.
+        int32_t body = mPhysicsManager.loadKinematicBody(0x1, 0x2, pSizeX, pSizeY);
+        slot = mPhysicsManager.getKinematicBodies().slot[body];
+        mKinematicBodies.push_back(body);
+    } else {
+        //Asteroid is a b2Body with cat1, and only collide with cat 2 objects
+        b2Body *body = mPhysicsManager.loadBody(0x1, 0x2, pSizeX, pSizeY, 2.0f);
+        slot = mPhysicsManager.getBodyIndex(body);
+        mBodies.push_back(body);
+    }
+    //The sprite reads its position straight from the physics state table.
+    pGraphics->bindBody(&mPhysicsManager.getBodyStates(), slot);
+    mSlots.push_back(slot);
+    mOutOfBounds.push_back(0);
 }
 
 void Asteroid::initialize() {
@@ -34,33 +58,73 @@ void Asteroid::initialize() {
     mLowerBound = -BOUNDS_MARGIN;
     mLeftBound = -BOUNDS_MARGIN;
     mRightBound = (mGraphicsManager.getRenderWidth()/PHYSICS_SCALE) + BOUNDS_MARGIN;
+    //Asteroids spawn above the screen: the hash grid spans their whole
+    //course, or half of them would share the top row of cells.
+    if (mKinematic) {
+        mPhysicsManager.getKinematicBodies().setBounds(mLeftBound, mLowerBound,
+                                                       mRightBound, mUpperBound);
+    }
 
-    std::vector<b2Body*>::iterator bodyIt;
-    for (bodyIt = mBodies.begin(); bodyIt < mBodies.end(); ++bodyIt){
-        spawn(*bodyIt);
+    int32_t count = mSlots.size();
+    for (int i = 0; i < count; ++i) {
+        mOutOfBounds[i] = i;
     }
+    spawn(count);
 }
 
 void Asteroid::update() {
-    std::vector<b2Body*>::iterator bodyIt;
-    for (bodyIt = mBodies.begin(); bodyIt < mBodies.end(); ++bodyIt){
-        b2Body* body = *bodyIt;
-        if ((body->GetPosition().x < mLeftBound)
-        || (body->GetPosition().x > mRightBound)
-        || (body->GetPosition().y < mLowerBound)
-        || (body->GetPosition().y > mUpperBound)){
-            spawn(body);
-        }
+    //Positions only change when the world steps.
+    int32_t count = mSlots.size();
+    if ((count == 0) || (mPhysicsManager.getStepCount() == 0)) return;
+
+    //Bounds test on the state table, in render units. No branch: every
+    //index is written and only those out of bounds advance the cursor.
+    const BodyStates &states = mPhysicsManager.getBodyStates();
+    const float *positionsX = &states.currentX[0];
+    const float *positionsY = &states.currentY[0];
+    const int32_t *slots = &mSlots[0];
+    int32_t *outOfBounds = &mOutOfBounds[0];
+    float leftBound = mLeftBound * PHYSICS_SCALE, rightBound = mRightBound * PHYSICS_SCALE;
+    float lowerBound = mLowerBound * PHYSICS_SCALE, upperBound = mUpperBound * PHYSICS_SCALE;
+    int32_t outCount = 0;
+    for (int i = 0; i < count; ++i) {
+        float x = positionsX[slots[i]], y = positionsY[slots[i]];
+        outOfBounds[outCount] = i;
+        outCount += int32_t((x < leftBound) | (x > rightBound)
+                            | (y < lowerBound) | (y > upperBound));
     }
+    spawn(outCount);
 }
 
-void Asteroid::spawn(b2Body *pBody) {
-    float velocity = -(RAND(VELOCITY_RANGE) + MIN_VELOCITY);
-    float posX = mLeftBound + RAND(mRightBound - mLeftBound);
-    float posY = mMinBound + RAND(mUpperBound - mMinBound);
+void Asteroid::refillRandomStream() {
+    mRandom.fill(&mRandomStream[0], RANDOM_STREAM_SIZE, 0.0f, 1.0f);
+    mRandomCursor = 0;
+}
+
+void Asteroid::spawn(int32_t pCount) {
+    KinematicBodies &kinematicBodies = mPhysicsManager.getKinematicBodies();
+    for (int i = 0; i < pCount; ++i) {
+        if (mRandomCursor + 3 > RANDOM_STREAM_SIZE) refillRandomStream();
+        const float *random = &mRandomStream[mRandomCursor];
+        mRandomCursor += 3;
+
+        float velocity = -(random[0] * VELOCITY_RANGE + MIN_VELOCITY);
+        float posX = mLeftBound + random[1] * (mRightBound - mLeftBound);
+        float posY = mMinBound + random[2] * (mUpperBound - mMinBound);
 
-    //Set the position of the body's origin and rotation. Manipulating a body's transform may cause non-physical behavior. Note: contacts are updated on the next call to b2World::Step.
-    pBody->SetTransform(b2Vec2(posX, posY), 0.0f);
-    //Set the velocity.
-    pBody->SetLinearVelocity(b2Vec2(0.0f, velocity));
+        int32_t asteroid = mOutOfBounds[i];
+        if (mKinematic) {
+            int32_t body = mKinematicBodies[asteroid];
+            kinematicBodies.x[body] = posX;
+            kinematicBodies.y[body] = posY;
+            kinematicBodies.velocityX[body] = 0.0f;
+            kinematicBodies.velocityY[body] = velocity;
+        } else {
+            b2Body *body = mBodies[asteroid];
+            //Set the position of the body's origin and rotation. Manipulating a body's transform may cause non-physical behavior. Note: contacts are updated on the next call to b2World::Step.
+            body->SetTransform(b2Vec2(posX, posY), 0.0f);
+            //Set the velocity.
+            body->SetLinearVelocity(b2Vec2(0.0f, velocity));
+        }
+    }
 }
@@ -0,0 +1,35 @@
+//
+// Created by cjf12 on 2019-11-05.
+//
+
+#include "include/BodyStates.h"
+
+BodyStates::BodyStates() :
+        x(), y(),
+        previousX(), previousY(),
+        currentX(), currentY() {
+}
+
+int32_t BodyStates::add() {
+    int32_t index = size();
+    x.push_back(0.0f);
+    y.push_back(0.0f);
+    previousX.push_back(0.0f);
+    previousY.push_back(0.0f);
+    currentX.push_back(0.0f);
+    currentY.push_back(0.0f);
+    return index;
+}
+
+
+void BodyStates::interpolate(float pAlpha) {
+    int32_t count = size();
+    if (count == 0) return;
+    const float *fromX = &previousX[0], *fromY = &previousY[0];
+    const float *toX = &currentX[0], *toY = &currentY[0];
+    float *outX = &x[0], *outY = &y[0];
+    for (int i = 0; i < count; ++i) {
+        outX[i] = fromX[i] + (toX[i] - fromX[i]) * pAlpha;
+        outY[i] = fromY[i] + (toY[i] - fromY[i]) * pAlpha;
+    }
+}
@@ -0,0 +1,19 @@
+//
+// Created by cjf12 on 2019-11-07.
+//
+
+#include "include/ContactEvents.h"
+
+ContactEventQueue::ContactEventQueue(int32_t pCapacity) :
+        mEvents(pCapacity),
+        mCount(0),
+        mDropped(0),
+        mDroppedBodies() {
+}
+
+void ContactEventQueue::markDropped(int32_t pBodyA, int32_t pBodyB) {
+    int32_t size = std::max(pBodyA, pBodyB) + 1;
+    if (size > int32_t(mDroppedBodies.size())) mDroppedBodies.resize(size, 0);
+    if (pBodyA >= 0) mDroppedBodies[pBodyA] = 1;
+    if (pBodyB >= 0) mDroppedBodies[pBodyB] = 1;
+}
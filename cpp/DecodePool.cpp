@@ -0,0 +1,136 @@
+//
+// Created by cjf12 on 2019-11-17.
+//
+
+#include "include/DecodePool.h"
+#include "include/Log.h"
+
+#include <algorithm>
+
+DecodePool::DecodePool(int32_t pThreadCount) :
+        mThreadCount(pThreadCount > 0 ? pThreadCount : 1),
+        mThreads(),
+        mRunning(false),
+        mQueuedJobs(), mActiveJobCount(0), mFinishedJobs() {
+    pthread_mutex_init(&mMutex, NULL);
+    pthread_cond_init(&mJobAdded, NULL);
+    pthread_cond_init(&mJobFinished, NULL);
+}
+
+DecodePool::~DecodePool() {
+    stop();
+    pthread_cond_destroy(&mJobFinished);
+    pthread_cond_destroy(&mJobAdded);
+    pthread_mutex_destroy(&mMutex);
+}
+
+status DecodePool::start() {
+    if (mRunning) return STATUS_OK;
+    mRunning = true;
+    for (int i = 0; i < mThreadCount; ++i) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, &DecodePool::work, this) != 0) {
+            Log::error("Error creating decode thread.");
+            stop();
+            return STATUS_KO;
+        }
+        mThreads.push_back(thread);
+    }
+    return STATUS_OK;
+}
+
+void DecodePool::stop() {
+    pthread_mutex_lock(&mMutex);
+    mRunning = false;
+    mQueuedJobs.clear();
+    pthread_cond_broadcast(&mJobAdded);
+    pthread_mutex_unlock(&mMutex);
+
+    for (int i = 0; i < int32_t(mThreads.size()); ++i) {
+        pthread_join(mThreads[i], NULL);
+    }
+    mThreads.clear();
+    mFinishedJobs.clear();
+    mActiveJobCount = 0;
+}
+
+void DecodePool::decode(Resource &pResource, bool pExpandToRGBA) {
+    pthread_mutex_lock(&mMutex);
+    mQueuedJobs.push_back(Job());
+    mQueuedJobs.back().resource = &pResource;
+    mQueuedJobs.back().expandToRGBA = pExpandToRGBA;
+    pthread_cond_signal(&mJobAdded);
+    pthread_mutex_unlock(&mMutex);
+}
+
+bool DecodePool::poll(Job &pJob, bool pWait) {
+    bool found = false;
+    pthread_mutex_lock(&mMutex);
+    if (pWait) {
+        while (mFinishedJobs.empty() && (!mQueuedJobs.empty() || (mActiveJobCount > 0))) {
+            pthread_cond_wait(&mJobFinished, &mMutex);
+        }
+    }
+    if (!mFinishedJobs.empty()) {
+        //Pixels are swapped, not copied.
+        Job &job = mFinishedJobs.front();
+        pJob.resource = job.resource;
+        pJob.expandToRGBA = job.expandToRGBA;
+        pJob.result = job.result;
+        std::swap(pJob.image, job.image);
+        mFinishedJobs.pop_front();
+        found = true;
+    }
+    pthread_mutex_unlock(&mMutex);
+    return found;
+}
+
+int32_t DecodePool::getPendingCount() {
+    pthread_mutex_lock(&mMutex);
+    int32_t count = mQueuedJobs.size() + mActiveJobCount + mFinishedJobs.size();
+    pthread_mutex_unlock(&mMutex);
+    return count;
+}
+
+void *DecodePool::work(void *pPool) {
+    DecodePool &pool = *(DecodePool *) pPool;
+    Job job;
+    while (pool.takeJob(job)) {
+        job.result = ImageDecoder::decode(*job.resource, job.image, job.expandToRGBA);
+        pool.finishJob(job);
+    }
+    return NULL;
+}
+
+bool DecodePool::takeJob(Job &pJob) {
+    pthread_mutex_lock(&mMutex);
+    while (mRunning && mQueuedJobs.empty()) {
+        pthread_cond_wait(&mJobAdded, &mMutex);
+    }
+    bool running = mRunning;
+    if (running) {
+        pJob.resource = mQueuedJobs.front().resource;
+        pJob.expandToRGBA = mQueuedJobs.front().expandToRGBA;
+        pJob.image = Image();
+        mQueuedJobs.pop_front();
+        ++mActiveJobCount;
+    }
+    pthread_mutex_unlock(&mMutex);
+    return running;
+}
+
+void DecodePool::finishJob(Job &pJob) {
+    pthread_mutex_lock(&mMutex);
+    --mActiveJobCount;
+    //Results of a stopped pool are dropped.
+    if (mRunning) {
+        mFinishedJobs.push_back(Job());
+        Job &job = mFinishedJobs.back();
+        job.resource = pJob.resource;
+        job.expandToRGBA = pJob.expandToRGBA;
+        job.result = pJob.result;
+        std::swap(job.image, pJob.image);
+    }
+    pthread_cond_broadcast(&mJobFinished);
+    pthread_mutex_unlock(&mMutex);
+}
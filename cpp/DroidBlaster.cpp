@@ -5,23 +5,36 @@
 #include "include/DroidBlaster.h"
 #include "include/Log.h"
 #include "include/Sound.h"
+#include "include/Profiler.h"
 #include <unistd.h>
+#include <time.h>
 
 static const int32_t SHIP_SIZE = 64;
 static const int32_t SHIP_FRAME_1 = 0;
 static const int32_t SHIP_FRAME_COUNT = 8;
 static const float SHIP_ANIM_SPEED = 8.0f;
 
-static const int32_t ASTEROID_COUNT = 16;
 static const int32_t ASTEROID_SIZE = 64;
 static const int32_t ASTEROID_FRAME_1 = 0;
 static const int32_t ASTEROID_FRAME_COUNT = 16;
 static const float ASTEROID_MIN_ANIM_SPEED = 16.0f;
 static const float ASTEROID_ANUM_SPEED_RANGE = 32.0f;
 
-static const int32_t STAR_COUNT = 50;
+//Sprite layers, drawn from the lowest.
+static const int32_t SHIP_LAYER = 0;
+static const int32_t ASTEROID_LAYER = 1;
 
-DroidBlaster::DroidBlaster(android_app *pApplication) :
+//Random stream of the game setup, see Random.
+static const uint32_t RANDOM_STREAM = 0;
+
+static uint64_t resolveSeed(const GameSettings &pSettings) {
+    if (pSettings.randomSeed != 0) return pSettings.randomSeed;
+    return uint64_t(time(NULL));
+}
+
+DroidBlaster::DroidBlaster(android_app *pApplication, const GameSettings &pSettings) :
+        mSeed(resolveSeed(pSettings)),
+        mRandom(mSeed, RANDOM_STREAM),
         mTimeManager(),
         mGraphicsManager(pApplication),
         mPhysicsManager(mTimeManager, mGraphicsManager),
@@ -33,26 +46,53 @@ DroidBlaster::DroidBlaster(android_app *pApplication) :
         mStarTexture(pApplication, "droidblaster/star.png"),
         mBGM(pApplication, "droidblaster/bgm.mp3"),
         mCollisionSound(pApplication, "droidblaster/collision.pcm"),
-        mShip(pApplication, mGraphicsManager, mSoundManager),
-        mStarField(pApplication, mTimeManager, mGraphicsManager, STAR_COUNT, mStarTexture),
-        mAsteroids(pApplication, mTimeManager, mGraphicsManager, mPhysicsManager),
-        mSpriteBatch(mTimeManager, mGraphicsManager),
+        mAtlas(),
+        mShip(pApplication, mGraphicsManager, mSoundManager, mPhysicsManager),
+        mStarField(pApplication, mTimeManager, mGraphicsManager, pSettings.starCount,
+                   mStarTexture, mSeed),
+        mAsteroids(pApplication, mTimeManager, mGraphicsManager, mPhysicsManager,
+                   pSettings.kinematicAsteroids, mSeed),
+        mSpriteBatch(mTimeManager, mGraphicsManager, pSettings.instancedSprites),
         mMoveableBody(pApplication, mInputManager, mPhysicsManager, mGraphicsManager) {
     Log::info("Creating DroidBlaster");
-    Sprite *shipGraphics = mSpriteBatch.registerSprite(mShipTexture, SHIP_SIZE, SHIP_SIZE);
+    mGraphicsManager.setImageCacheBudget(pSettings.imageCacheBudget);
+    //Sprite and star sheets share a texture.
+    if (pSettings.textureAtlas) {
+        mAtlas.addSheet(mShipTexture);
+        mAtlas.addSheet(mAsteroidTexture);
+        mAtlas.addSheet(mStarTexture);
+        mGraphicsManager.registerAtlas(&mAtlas);
+    }
+    mPhysicsManager.setFixedTimeStep(pSettings.physicsFrequency, pSettings.physicsMaxSubSteps);
+    //Ship and asteroids bodies, allocated in one go.
+    mPhysicsManager.reserveBodies(
+            pSettings.kinematicAsteroids ? 1 : 1 + pSettings.asteroidCount);
+    //Ship, asteroids and decorative sprites, stored in one pool with room
+    //for the ones registered later on.
+    mSpriteBatch.reserveSprites(1 + pSettings.asteroidCount + pSettings.extraSpriteCount
+                                + pSettings.spriteHeadroom);
+    Sprite *shipGraphics = mSpriteBatch.registerSprite(mShipTexture, SHIP_SIZE, SHIP_SIZE,
+                                                      SHIP_LAYER);
     shipGraphics->setAnimation(SHIP_FRAME_1, SHIP_FRAME_COUNT, SHIP_ANIM_SPEED, true);
     Sound *collisionSOund = mSoundManager.registerSound(mCollisionSound);
-    b2Body* shipBody = mMoveableBody.registerMoveableBody(shipGraphics->location, SHIP_SIZE, SHIP_SIZE);
+    b2Body* shipBody = mMoveableBody.registerMoveableBody(shipGraphics, SHIP_SIZE, SHIP_SIZE);
     mShip.registerShip(shipGraphics, collisionSOund, shipBody);
 
 
-    for (int i = 0; i < ASTEROID_COUNT; ++i) {
+    for (int i = 0; i < pSettings.asteroidCount; ++i) {
         Sprite *asteroidGraphics = mSpriteBatch.registerSprite(mAsteroidTexture, ASTEROID_SIZE,
-                                                               ASTEROID_SIZE);
-        float animSpeed = ASTEROID_MIN_ANIM_SPEED + RAND(ASTEROID_ANUM_SPEED_RANGE);
+                                                               ASTEROID_SIZE, ASTEROID_LAYER);
+        float animSpeed = ASTEROID_MIN_ANIM_SPEED + mRandom.nextFloat(ASTEROID_ANUM_SPEED_RANGE);
         asteroidGraphics->setAnimation(ASTEROID_FRAME_1, ASTEROID_FRAME_COUNT, animSpeed, true);
-        mAsteroids.registerAsteroid(
-                asteroidGraphics->location, ASTEROID_SIZE, ASTEROID_SIZE);
+        mAsteroids.registerAsteroid(asteroidGraphics, ASTEROID_SIZE, ASTEROID_SIZE);
+    }
+
+    //Decorative sprites, drawn but not simulated.
+    for (int i = 0; i < pSettings.extraSpriteCount; ++i) {
+        Sprite *extraGraphics = mSpriteBatch.registerSprite(mAsteroidTexture, ASTEROID_SIZE,
+                                                            ASTEROID_SIZE, ASTEROID_LAYER);
+        extraGraphics->setAnimation(ASTEROID_FRAME_1, ASTEROID_FRAME_COUNT,
+                                    ASTEROID_MIN_ANIM_SPEED, true);
     }
 
 }
@@ -89,15 +129,23 @@ void DroidBlaster::onDeactivate() {
 
 
 status DroidBlaster::onStep() {
+    PROFILE_BEGIN();
     mTimeManager.update();
+    PROFILE_MARK(Profiler::STAGE_TIME);
     mPhysicsManager.update();
+    PROFILE_MARK(Profiler::STAGE_PHYSICS);
 
     mAsteroids.update();
+    PROFILE_MARK(Profiler::STAGE_ASTEROIDS);
     mMoveableBody.update();
+    PROFILE_MARK(Profiler::STAGE_MOVEABLE_BODY);
     mShip.update();
+    PROFILE_MARK(Profiler::STAGE_SHIP);
 
     if (mShip.isDestroyed()) return STATUS_EXIT;
-    return mGraphicsManager.update();
+    status result = mGraphicsManager.update();
+    PROFILE_MARK(Profiler::STAGE_GRAPHICS);
+    return result;
 }
 
 void DroidBlaster::onStart() {
@@ -0,0 +1,29 @@
+//
+// Created by cjf12 on 2019-11-15.
+//
+
+#include "include/FrameTable.h"
+
+void FrameTable::build(int32_t pSheetWidth, int32_t pSheetHeight,
+                       GLfloat pU1, GLfloat pV1, GLfloat pU2, GLfloat pV2,
+                       int32_t pFrameWidth, int32_t pFrameHeight) {
+    GLfloat texelU = (pU2 - pU1) / GLfloat(pSheetWidth);
+    GLfloat texelV = (pV2 - pV1) / GLfloat(pSheetHeight);
+    frameXCount = pSheetWidth / pFrameWidth;
+    frameYCount = pSheetHeight / pFrameHeight;
+    frameCount = frameXCount * frameYCount;
+    originU = pU1;
+    originV = pV1;
+    frameWidth = GLfloat(pFrameWidth) * texelU;
+    frameHeight = GLfloat(pFrameHeight) * texelV;
+    u.resize(frameCount);
+    v.resize(frameCount);
+    //Frames are numbered from the top-left corner of the sheet, whose
+    //rows are stored bottom-up.
+    for (int i = 0; i < frameCount; ++i) {
+        int32_t frameX = i % frameXCount;
+        int32_t frameY = frameYCount - 1 - (i / frameXCount);
+        u[i] = pU1 + GLfloat(frameX * pFrameWidth) * texelU;
+        v[i] = pV1 + GLfloat(frameY * pFrameHeight) * texelV;
+    }
+}
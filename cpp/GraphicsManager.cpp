@@ -4,9 +4,20 @@
 
 #include "include/GraphicsManager.h"
 #include "include/Log.h"
-#include "Libraries/libpng/png.h"
+#include <algorithm>
 #include <stdio.h>
 #include <string.h>
+#include <string>
+#include <unistd.h>
+
+//Decoded images kept for the next context, by default.
+static const int64_t DEFAULT_IMAGE_CACHE_BUDGET = 16 * 1024 * 1024;
+
+//Decoding threads, leaving a core to the GL thread.
+static int32_t getDecodeThreadCount() {
+    long cpuCount = sysconf(_SC_NPROCESSORS_ONLN);
+    return std::max(1L, std::min(cpuCount - 1, 4L));
+}
 
 GraphicsManager::GraphicsManager(android_app *pApplication) :
         mApplication(pApplication),
@@ -14,7 +25,11 @@ GraphicsManager::GraphicsManager(android_app *pApplication) :
         mDisplay(EGL_NO_DISPLAY), mSurface(EGL_NO_CONTEXT),
         mContext(EGL_NO_SURFACE),
         mProjectionMatrix(),
-        mTextures(),
+        mTextures(), mAtlases(), mFrameTables(),
+        mDecodePool(getDecodeThreadCount()),
+        mImageCache(DEFAULT_IMAGE_CACHE_BUDGET),
+        mCompressedResources(), mAlphaTextures(),
+        mProgramCache(),
         mShaders(),
         mVertexBuffers(),
         mComponents(),
@@ -22,12 +37,28 @@ GraphicsManager::GraphicsManager(android_app *pApplication) :
         mRenderFrameBuffer(0), mRenderVertexBuffer(0),
         mRenderTexture(0), mRenderShaderProgram(0),
         aPosition(0), aTexture(0),
-        uProjection(0), uTexture(0) {
+        uProjection(0), uTexture(0),
+        mDrawElementsInstanced(NULL), mVertexAttribDivisor(NULL),
+        mCompressedETC1(false), mCompressedETC2(false),
+        mGetProgramBinary(NULL), mProgramBinary(NULL) {
     Log::info("Creating GraphicsManager.");
+    //Program binaries are saved with the application private files.
+    if ((pApplication != NULL) && (pApplication->activity != NULL)
+        && (pApplication->activity->internalDataPath != NULL)) {
+        mProgramCache.setDirectory(
+                std::string(pApplication->activity->internalDataPath) + "/programs");
+    }
 }
 
 GraphicsManager::~GraphicsManager() {
     Log::info("Destroying GraphicsManager.");
+    std::map<Resource *, CompressedResources>::iterator resourceIt;
+    for (resourceIt = mCompressedResources.begin();
+         resourceIt != mCompressedResources.end();
+         ++resourceIt) {
+        delete resourceIt->second.color;
+        delete resourceIt->second.alpha;
+    }
 }
 
 void GraphicsManager::registerComponent(GraphicsComponent *pComponent) {
@@ -81,6 +112,10 @@ status GraphicsManager::start() {
         (mScreenWidth <= 0) || (mScreenHeight <= 0))
         goto ERROR;
 
+    //Extensions first: the offscreen surface shader already goes through
+    //the program binary cache.
+    loadExtensions();
+
     //Defines and initializes offscreen surface.
     if (initializeRenderBuffer() != STATUS_OK) goto ERROR;
 
@@ -102,8 +137,10 @@ status GraphicsManager::start() {
     Log::info("Vendor    : %s", glGetString(GL_VENDOR));
     Log::info("Renderer  : %s", glGetString(GL_RENDERER));
     Log::info("Offscreen : %d x %d", mRenderWidth, mRenderHeight);
+    if (mDecodePool.start() != STATUS_OK) goto ERROR;
 
-    //Loads graphics components.
+    //Loads graphics components. Textures they request are decoded in the
+    //background and uploaded by update() as they come.
     for (std::vector<GraphicsComponent *>::iterator componentIt = mComponents.begin();
          componentIt < mComponents.end();
          ++componentIt) {
@@ -120,11 +157,26 @@ status GraphicsManager::start() {
 
 void GraphicsManager::stop() {
     Log::info("Stopping GraphicsManager");
+    //Decodes in progress are waited for, pending ones dropped.
+    mDecodePool.stop();
+
     // Releases textures.
     std::map<Resource *, TextureProperties>::iterator textureIt;
     for (textureIt = mTextures.begin(); textureIt != mTextures.end(); ++textureIt) {
+        //Sheets of an atlas share their texture: deleting it again
+        //is ignored by GL.
         glDeleteTextures(1, &textureIt->second.texture);
     }
+    mTextures.clear();
+    std::map<GLuint, GLuint>::iterator alphaTextureIt;
+    for (alphaTextureIt = mAlphaTextures.begin();
+         alphaTextureIt != mAlphaTextures.end();
+         ++alphaTextureIt) {
+        glDeleteTextures(1, &alphaTextureIt->second);
+    }
+    mAlphaTextures.clear();
+    //Built from texture areas, which may change with the next atlas.
+    mFrameTables.clear();
 
     // Release shaders.
     std::vector<GLuint>::iterator shaderIt;
@@ -174,7 +226,87 @@ void GraphicsManager::stop() {
 
 }
 
+//Looks for a whole token in a space-separated extension list.
+static bool hasExtension(const char *pExtensions, const char *pName) {
+    if (pExtensions == NULL) return false;
+    size_t length = strlen(pName);
+    const char *extension = pExtensions;
+    while ((extension = strstr(extension, pName)) != NULL) {
+        if (((extension == pExtensions) || (extension[-1] == ' '))
+            && ((extension[length] == ' ') || (extension[length] == '\0'))) {
+            return true;
+        }
+        extension += length;
+    }
+    return false;
+}
+
+void GraphicsManager::loadExtensions() {
+    const char *version = (const char *) glGetString(GL_VERSION);
+    const char *extensions = (const char *) glGetString(GL_EXTENSIONS);
+
+    //Instanced draws are core in GLES 3 and an extension in GLES 2.
+    mDrawElementsInstanced = NULL;
+    mVertexAttribDivisor = NULL;
+    if ((version != NULL) && (strncmp(version, "OpenGL ES 3", 11) == 0)) {
+        mDrawElementsInstanced = (PFNGLDRAWELEMENTSINSTANCEDEXTPROC)
+                eglGetProcAddress("glDrawElementsInstanced");
+        mVertexAttribDivisor = (PFNGLVERTEXATTRIBDIVISOREXTPROC)
+                eglGetProcAddress("glVertexAttribDivisor");
+    } else if (hasExtension(extensions, "GL_EXT_instanced_arrays")) {
+        mDrawElementsInstanced = (PFNGLDRAWELEMENTSINSTANCEDEXTPROC)
+                eglGetProcAddress("glDrawElementsInstancedEXT");
+        mVertexAttribDivisor = (PFNGLVERTEXATTRIBDIVISOREXTPROC)
+                eglGetProcAddress("glVertexAttribDivisorEXT");
+    }
+    if ((mDrawElementsInstanced == NULL) || (mVertexAttribDivisor == NULL)) {
+        mDrawElementsInstanced = NULL;
+        mVertexAttribDivisor = NULL;
+    }
+    Log::info("Instancing: %s", hasInstancing() ? "yes" : "no");
+
+    //ETC2 is core in GLES 3, ETC1 an extension before.
+    mCompressedETC2 = (version != NULL) && (strncmp(version, "OpenGL ES 3", 11) == 0);
+    mCompressedETC1 = hasExtension(extensions, "GL_OES_compressed_ETC1_RGB8_texture");
+    Log::info("Compressed textures: ETC1 %s, ETC2 %s", mCompressedETC1 ? "yes" : "no",
+              mCompressedETC2 ? "yes" : "no");
+
+    //Program binaries are core in GLES 3 and an extension in GLES 2, but
+    //useless without any binary format.
+    mGetProgramBinary = NULL;
+    mProgramBinary = NULL;
+    if ((version != NULL) && (strncmp(version, "OpenGL ES 3", 11) == 0)) {
+        mGetProgramBinary = (PFNGLGETPROGRAMBINARYOESPROC)
+                eglGetProcAddress("glGetProgramBinary");
+        mProgramBinary = (PFNGLPROGRAMBINARYOESPROC) eglGetProcAddress("glProgramBinary");
+    } else if (hasExtension(extensions, "GL_OES_get_program_binary")) {
+        mGetProgramBinary = (PFNGLGETPROGRAMBINARYOESPROC)
+                eglGetProcAddress("glGetProgramBinaryOES");
+        mProgramBinary = (PFNGLPROGRAMBINARYOESPROC) eglGetProcAddress("glProgramBinaryOES");
+    }
+    GLint binaryFormatCount = 0;
+    if ((mGetProgramBinary != NULL) && (mProgramBinary != NULL)) {
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS_OES, &binaryFormatCount);
+    }
+    if (binaryFormatCount <= 0) {
+        mGetProgramBinary = NULL;
+        mProgramBinary = NULL;
+    }
+    //Binaries are only valid for the driver which built them.
+    std::string driver;
+    const GLenum driverStrings[] = {GL_VENDOR, GL_RENDERER, GL_VERSION};
+    for (int i = 0; i < 3; ++i) {
+        const char *driverString = (const char *) glGetString(driverStrings[i]);
+        driver += (driverString != NULL) ? driverString : "";
+        driver += '\n';
+    }
+    mProgramCache.setDriver(driver);
+    Log::info("Program binaries: %s", (mProgramBinary != NULL) ? "yes" : "no");
+}
+
 status GraphicsManager::update() {
+    uploadTextures();
+
     glBindFramebuffer(GL_FRAMEBUFFER,
                       mRenderFrameBuffer); // glBindFramebuffer binds the framebuffer object with name framebuffer to the framebuffer target specified by target.
     glViewport(0, 0, mRenderWidth,
@@ -232,11 +364,8 @@ status GraphicsManager::update() {
     }
 }
 
-void callback_readPng(png_structp pStruct, png_bytep pData, png_size_t pSize) {
-    Resource *resource = ((Resource *) png_get_io_ptr(pStruct));
-    if (resource->read(pData, pSize) != STATUS_OK) {
-        resource->close();
-    }
+void GraphicsManager::registerAtlas(TextureAtlas *pAtlas) {
+    mAtlases.push_back(pAtlas);
 }
 
 TextureProperties *GraphicsManager::loadTexture(Resource &pResource) {
@@ -247,122 +376,209 @@ TextureProperties *GraphicsManager::loadTexture(Resource &pResource) {
         return &textureIt->second;
     }
 
+    //Sheets of an atlas are loaded all together, the first time one of
+    //them is requested.
+    std::vector<TextureAtlas *>::iterator atlasIt;
+    for (atlasIt = mAtlases.begin(); atlasIt < mAtlases.end(); ++atlasIt) {
+        if ((*atlasIt)->findSheet(pResource) >= 0) {
+            if (loadAtlas(**atlasIt) != STATUS_OK) return NULL;
+            textureIt = mTextures.find(&pResource);
+            if (textureIt != mTextures.end()) return &textureIt->second;
+            //Not packed, loaded on its own below.
+        }
+    }
+
     Log::info("Loading texture %s", pResource.getPath());
 
+    Image placeholder;
     TextureProperties *textureProperties;
     GLuint texture;
-    GLint format;
-    png_byte header[8];
-    png_structp pngPtr = NULL;
-    png_infop infoPtr = NULL;
-    png_byte *image = NULL;
-    png_bytep *rowPtrs = NULL;
-    png_int_32 rowSize;
-    bool transparency;
-
-    if (pResource.open() != STATUS_OK) goto ERROR;
-    Log::info("Checking signature.");
-    if (pResource.read(header, sizeof(header)) != STATUS_OK) goto ERROR;
-    if (png_sig_cmp(header, 0, 8) != 0)
-        goto ERROR;  //png_sig_cmp() checks whether the given number of bytes match the PNG signature starting from the start position. The function shall return non-zero if num_to_check == 0 or start > 7.
-
-    Log::info("Creating required structures.");
-    pngPtr = png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL, NULL,
-                                    NULL); // allocate and initialize a png_struct structure for reading PNG file
-    if (!pngPtr) goto ERROR;
-    infoPtr = png_create_info_struct(pngPtr); //allocate and initialize a png_info structure
-    if (!infoPtr) goto ERROR;
-
-    //prepare reading operation by setting up a read callback.
-    png_set_read_fn(pngPtr, &pResource,
-                    callback_readPng);  //set user-defined function for reading a PNG stream. png_set_read_fn() sets the read_data_fn as the input function for reading PNG files instead of using standard C I/O stream functions. png_ptr - pointer to input data structure png_struct io_ptr - pointer to user-defined structure containing information about the input functions. This value may be NULL. read_data_fn - pointer to new input function that shall take the following arguments: - a pointer to a png_struct - a pointer to a structure where input data can be stored - 32-bit unsigned int to indicate number of bytes to read The input function should invoke png_error() to handle any fatal errors and png_warning() to handle non-fatal errors.
-    //Set up error management. If an error occurs while reading.
-    // code will come back here and jump
-    if (setjmp(png_jmpbuf(pngPtr))) goto ERROR;
-
-    //Ignores first 8 bytes already read.
-    png_set_sig_bytes(pngPtr,
-                      8); //png_set_sig_bytes() shall store the number of bytes of the PNG file signature that have been read from the PNG stream.
-
-    // Retrieved PNG info and updates PNG struct accordingly.
-    png_int_32 depth, colorType;
-    png_uint_32 width, height;
-    png_read_info(pngPtr,
-                  infoPtr); //Reads the information before the actual image data from the PNG file. The function allows reading a file that already has the PNG signature bytes read from the stream.
-    png_get_IHDR(pngPtr, infoPtr, &width, &height, &depth, &colorType, NULL, NULL,
-                 NULL); //png_get_IHDR() gets PNG_IHDR chunk type information from png_info structure.
-
-    //Creates a full alpha channel if transparency is encoded as
-    //an array of palette entries or a single transparent color.
-    transparency = false;
-    if (png_get_valid(pngPtr, infoPtr,
-                      PNG_INFO_tRNS)) { //determine if given chunk data is valid (PNG_INFO_tRNS means transparency data for images)
-        png_set_tRNS_to_alpha(
-                pngPtr); // png_set_tRNS_to_alpha() shall set transformation in png_ptr such that tRNS chunks are expanded to alpha channels.
-        transparency = true;
-    }
-
-    //Expands PNG with less than 8bits per channel to 8 bits.
-    if (depth < 8) {
-        png_set_packing(
-                pngPtr); //png_set_packing() shall expand image to 1 pixel per byte for bit-depths 1, 2 and 4 without changing the order of the pixels. If png_set_packing() is not called, PNG files pack pixels of bit_depths 1, 2 and 4 into bytes as small as possible, for example, 8 pixels per byte for 1-bit files.
-        //Shrinks PNG with 16 bits per color channel down to 8 bits.
-    } else if (depth == 16) {
-        png_set_strip_16(
-                pngPtr); //png_set_strip_16() shall strip the pixels of a PNG stream with 16 bits per channel to 8 bits per channel.
-    }
-
-    //Indicates that image needs conversion to TGBA if needed.
-    switch (colorType) {
-        case PNG_COLOR_TYPE_PALETTE:
-            png_set_palette_to_rgb(
-                    pngPtr); //png_set_palette_to_rgb() shall set transformation in png_ptr such that paletted images are expanded to RGB
-            format = transparency ? GL_RGBA : GL_RGB;
-            break;
-        case PNG_COLOR_TYPE_RGB:
-            format = transparency ? GL_RGBA : GL_RGB;
-            break;
-        case PNG_COLOR_TYPE_RGBA:
-            format = GL_RGBA;
-            break;
-        case PNG_COLOR_TYPE_GRAY:
-            png_set_expand_gray_1_2_4_to_8(
-                    pngPtr); // As of libpng version 1.2.9, png_set_expand_gray_1_2_4_to_8() was added.  It expands the sample depth without changing tRNS to alpha.
-            format = transparency ? GL_LUMINANCE_ALPHA : GL_LUMINANCE;
-            break;
-        case PNG_COLOR_TYPE_GA:
-            png_set_expand_gray_1_2_4_to_8(pngPtr);
-            format = GL_LUMINANCE_ALPHA;
-            break;
-    }
-
-    //Validates all transformations.
-    png_read_update_info(pngPtr,
-                         infoPtr); //png_read_update_info() updates the structure pointed to by info_ptr to reflect any transformations that have been requested. For example, row bytes will be updated to handle expansion of an interlaced image with png_read_update_info().
-
-    //Get row size in bytes.
-    rowSize = png_get_rowbytes(pngPtr, infoPtr); //Return number of bytes for a row
-    if (rowSize <= 0) goto ERROR;
-    //Creates the image buffer that will be sent to OpenGL.
-    image = new png_byte[rowSize * height];
-    if (!image) goto ERROR;
-    //Pointers to each row of the image buffer. Row order is
-    // inverted becase different coordinate system are used by
-    //OpenGL (1st pixel is at bottom left) and PNGs(top left).
-    rowPtrs = new png_bytep[height];
-    if (!rowPtrs) goto ERROR;
-    for (int i = 0; i < height; ++i) {
-        rowPtrs[height - (i + 1)] = image + i * rowSize; //the index is reversed?!
-    }
-
-    //Reads image content.
-    png_read_image(pngPtr, rowPtrs); // read the entire image into memory
-    //Free memory and resources.
-    pResource.close();
-    png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
-    delete[] rowPtrs; //free the memory associated with read png_struct
-
-    GLenum errorResult;
+    int32_t width, height;
+    const Image *cachedImage;
+    //Compressed textures need no decoding and are uploaded right away.
+    texture = loadCompressedTexture(pResource, width, height);
+    if (texture != 0) goto LOADED;
+
+    //Images decoded before a context loss are only uploaded again.
+    cachedImage = mImageCache.find(pResource.getPath());
+    if (cachedImage != NULL) {
+        width = cachedImage->width;
+        height = cachedImage->height;
+        texture = loadTexture(*cachedImage);
+        if (texture == 0) goto ERROR;
+    } else {
+        //Only the size is read now: the texture holds a transparent
+        //placeholder until the image is decoded and uploaded by update().
+        if (ImageDecoder::readSize(pResource, width, height) != STATUS_OK) goto ERROR;
+        placeholder.width = 1;
+        placeholder.height = 1;
+        placeholder.format = GL_RGBA;
+        placeholder.pixels.assign(4, 0);
+        texture = loadTexture(placeholder);
+        if (texture == 0) goto ERROR;
+        mDecodePool.decode(pResource);
+    }
+
+    LOADED:
+
+    //Caches the loaded texture.
+    textureProperties = &mTextures[&pResource];
+    textureProperties->texture = texture;
+    textureProperties->width = width;
+    textureProperties->height = height;
+    textureProperties->u1 = 0.0f;
+    textureProperties->v1 = 0.0f;
+    textureProperties->u2 = 1.0f;
+    textureProperties->v2 = 1.0f;
+    return textureProperties;
+
+    ERROR:
+    Log::error("Error loading texture into OpenGL.");
+    return NULL;
+}
+
+const FrameTable *GraphicsManager::loadFrameTable(Resource &pResource,
+                                                 int32_t pFrameWidth, int32_t pFrameHeight) {
+    FrameTableKey key(&pResource, (uint64_t(uint32_t(pFrameWidth)) << 32) | uint32_t(pFrameHeight));
+    std::map<FrameTableKey, FrameTable>::iterator frameTableIt = mFrameTables.find(key);
+    if (frameTableIt != mFrameTables.end()) {
+        return &frameTableIt->second;
+    }
+
+    TextureProperties *textureProperties = loadTexture(pResource);
+    if (textureProperties == NULL) return NULL;
+    if ((pFrameWidth <= 0) || (pFrameHeight <= 0)
+        || (pFrameWidth > textureProperties->width)
+        || (pFrameHeight > textureProperties->height)) {
+        Log::error("Invalid frame size %d x %d for %s", pFrameWidth, pFrameHeight,
+                   pResource.getPath());
+        return NULL;
+    }
+
+    FrameTable *frameTable = &mFrameTables[key];
+    frameTable->id = mFrameTables.size();
+    frameTable->build(textureProperties->width, textureProperties->height,
+                      textureProperties->u1, textureProperties->v1,
+                      textureProperties->u2, textureProperties->v2,
+                      pFrameWidth, pFrameHeight);
+    return frameTable;
+}
+
+void GraphicsManager::uploadTextures() {
+    DecodePool::Job job;
+    while (mDecodePool.poll(job)) {
+        uploadTexture(job);
+    }
+}
+
+void GraphicsManager::uploadTexture(DecodePool::Job &pJob) {
+    std::map<Resource*, TextureProperties>::iterator textureIt = mTextures.find(pJob.resource);
+    if (textureIt == mTextures.end()) return;
+    TextureProperties &textureProperties = textureIt->second;
+    if (pJob.result != STATUS_OK) {
+        Log::error("Error loading texture %s.", pJob.resource->getPath());
+    } else if ((pJob.image.width != textureProperties.width)
+               || (pJob.image.height != textureProperties.height)) {
+        Log::error("Texture %s does not match its header.", pJob.resource->getPath());
+    } else if ((pJob.expandToRGBA
+                ? updateAtlasSheet(*pJob.resource, textureProperties.texture, pJob.image)
+                : updateTexture(textureProperties.texture, pJob.image)) != STATUS_OK) {
+        //Only atlas sheets are decoded as RGBA.
+        Log::error("Error loading texture into OpenGL.");
+    } else {
+        mImageCache.insert(pJob.resource->getPath(), pJob.image);
+    }
+}
+
+status GraphicsManager::loadAtlas(TextureAtlas &pAtlas) {
+    //Pages are laid out from sheet sizes alone and created transparent
+    //right away, so that every sheet gets its final texture and area:
+    //sprites and frame tables loaded now never change. Sheets are then
+    //decoded in the background, unless cached as RGBA, and copied into
+    //their page by update() as they come.
+    int32_t sheetCount = pAtlas.getSheetCount();
+    std::vector<Image> sizes(sheetCount);
+    std::vector<const Image *> cachedImages(sheetCount, NULL);
+    std::vector<GLuint> pageTextures;
+    for (int i = 0; i < sheetCount; ++i) {
+        Resource &sheet = pAtlas.getSheet(i);
+        //Compressed sheets cannot be packed and are left out.
+        if (findCompressedResources(sheet).color != NULL) continue;
+        const Image *cachedImage = mImageCache.find(sheet.getPath());
+        if ((cachedImage != NULL) && (cachedImage->format == GL_RGBA)) {
+            cachedImages[i] = cachedImage;
+            sizes[i].width = cachedImage->width;
+            sizes[i].height = cachedImage->height;
+        } else if (ImageDecoder::readSize(sheet, sizes[i].width, sizes[i].height) != STATUS_OK) {
+            //Left out: reported when loaded on its own.
+            sizes[i].width = 0;
+            sizes[i].height = 0;
+        }
+    }
+    if (pAtlas.layout(sizes) != STATUS_OK) goto ERROR;
+
+    for (int i = 0; i < pAtlas.getPageCount(); ++i) {
+        Image blankPage = pAtlas.getPage(i);
+        blankPage.pixels.assign(size_t(blankPage.width) * blankPage.height * 4, 0);
+        GLuint texture = loadTexture(blankPage);
+        if (texture == 0) goto ERROR;
+        pageTextures.push_back(texture);
+    }
+
+    for (int i = 0; i < sheetCount; ++i) {
+        const TextureAtlas::Region &region = pAtlas.getRegion(i);
+        if (region.page < 0) continue;
+        const Image &page = pAtlas.getPage(region.page);
+
+        //Sheet properties stay those of the sheet, plus its area in the
+        //page texture.
+        Resource &sheet = pAtlas.getSheet(i);
+        TextureProperties *textureProperties = &mTextures[&sheet];
+        textureProperties->texture = pageTextures[region.page];
+        textureProperties->width = region.width;
+        textureProperties->height = region.height;
+        textureProperties->u1 = GLfloat(region.x) / GLfloat(page.width);
+        textureProperties->v1 = GLfloat(region.y) / GLfloat(page.height);
+        textureProperties->u2 = GLfloat(region.x + region.width) / GLfloat(page.width);
+        textureProperties->v2 = GLfloat(region.y + region.height) / GLfloat(page.height);
+
+        if (cachedImages[i] == NULL) {
+            mDecodePool.decode(sheet, true);
+        } else if (updateAtlasSheet(sheet, textureProperties->texture, *cachedImages[i])
+                   != STATUS_OK) {
+            Log::error("Error loading texture into OpenGL.");
+        }
+    }
+    return STATUS_OK;
+
+    ERROR:
+    Log::error("Error loading texture atlas.");
+    if (!pageTextures.empty()) glDeleteTextures(pageTextures.size(), &pageTextures[0]);
+    return STATUS_KO;
+}
+
+status GraphicsManager::updateAtlasSheet(Resource &pResource, GLuint pTexture,
+                                         const Image &pImage) {
+    std::vector<TextureAtlas *>::iterator atlasIt;
+    for (atlasIt = mAtlases.begin(); atlasIt < mAtlases.end(); ++atlasIt) {
+        int32_t sheet = (*atlasIt)->findSheet(pResource);
+        if (sheet < 0) continue;
+        const TextureAtlas::Region &region = (*atlasIt)->getRegion(sheet);
+        if ((region.page < 0) || (pImage.format != GL_RGBA)) return STATUS_KO;
+
+        //Sheets and pages are both stored bottom-up: rows land as is.
+        glBindTexture(GL_TEXTURE_2D, pTexture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, region.x, region.y, region.width, region.height,
+                        GL_RGBA, GL_UNSIGNED_BYTE, &pImage.pixels[0]);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return (glGetError() == GL_NO_ERROR) ? STATUS_OK : STATUS_KO;
+    }
+    return STATUS_KO;
+}
+
+GLuint GraphicsManager::createTexture() {
+    GLuint texture;
     glGenTextures(1,
                   &texture); //glGenTextures returns n texture names in textures. There is no guarantee that the names form a contiguous set of integers; however, it is guaranteed that none of the returned names was in use immediately before the call to glGenTextures.
     //The generated textures have no dimensionality; they assume the dimensionality of the texture target to which they are first bound (see glBindTexture).
@@ -391,40 +607,165 @@ TextureProperties *GraphicsManager::loadTexture(Resource &pResource) {
     //Sets the wrap parameter for texture coordinate s to either GL_CLAMP_TO_EDGE, GL_MIRRORED_REPEAT, or GL_REPEAT.
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     // Sets the wrap parameter for texture coordinate s to either GL_CLAMP_TO_EDGE, GL_MIRRORED_REPEAT, or GL_REPEAT.
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return texture;
+}
 
-    //Load iamge data into OpenGL.
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE,
-                 image); //specify a two-dimensional texture image
+GLuint GraphicsManager::loadTexture(const Image &pImage) {
+    GLuint texture = createTexture();
+    if (updateTexture(texture, pImage) != STATUS_OK) {
+        glDeleteTextures(1, &texture);
+        return 0;
+    }
+    return texture;
+}
+
+status GraphicsManager::updateTexture(GLuint pTexture, const Image &pImage) {
+    glBindTexture(GL_TEXTURE_2D, pTexture);
+    //Samples mip levels when the image comes with them.
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                    (pImage.levelCount > 1) ? GL_NEAREST_MIPMAP_NEAREST : GL_NEAREST);
+    //Rows and levels are tightly packed, whatever the pixel size.
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    //Load iamge data into OpenGL, one level after the other.
+    const uint8_t *pixels = &pImage.pixels[0];
+    for (int32_t level = 0; level < pImage.levelCount; ++level) {
+        int32_t width = std::max(pImage.width >> level, 1);
+        int32_t height = std::max(pImage.height >> level, 1);
+        glTexImage2D(GL_TEXTURE_2D, level, pImage.format, width, height, 0,
+                     pImage.format, GL_UNSIGNED_BYTE,
+                     pixels); //specify a two-dimensional texture image
+        pixels += ImageDecoder::getByteCount(width, height, pImage.format, 1);
+    }
     //Finished working with the texture.
     glBindTexture(GL_TEXTURE_2D,
                   0); //bind a named texture to a texturing target , 0 is the texture name
-    delete[] image;
-    if (glGetError() != GL_NO_ERROR) goto ERROR;
-    Log::info("Texture size: %d x %d", width, height);
+    if (glGetError() != GL_NO_ERROR) return STATUS_KO;
+    Log::info("Texture size: %d x %d", pImage.width, pImage.height);
+    return STATUS_OK;
+}
 
-    //Caches the loaded texture.
-    textureProperties = &mTextures[&pResource];
-    textureProperties->texture = texture;
-    textureProperties->width = width;
-    textureProperties->height = height;
-    return textureProperties;
+GraphicsManager::CompressedResources &GraphicsManager::findCompressedResources(
+        Resource &pResource) {
+    std::map<Resource *, CompressedResources>::iterator resourceIt =
+            mCompressedResources.find(&pResource);
+    if (resourceIt != mCompressedResources.end()) return resourceIt->second;
+
+    //"ship.ktx" or "ship.pkm" stand for "ship.png", with an optional
+    //"ship_alpha.ktx" or "ship_alpha.pkm" alpha plane for ETC1.
+    static const char *EXTENSIONS[] = {".ktx", ".pkm"};
+    CompressedResources &resources = mCompressedResources[&pResource];
+    resources.color = NULL;
+    resources.alpha = NULL;
+    std::string name = pResource.getName();
+    std::string::size_type extension = name.rfind('.');
+    if ((extension != std::string::npos) && (name.find('/', extension) == std::string::npos)) {
+        name.erase(extension);
+    }
+    for (int i = 0; (i < 2) && (resources.color == NULL); ++i) {
+        Resource *color = new Resource(mApplication, (name + EXTENSIONS[i]).c_str());
+        if (color->getLength() < 0) {
+            delete color;
+            continue;
+        }
+        resources.color = color;
+        Resource *alpha = new Resource(mApplication, (name + "_alpha" + EXTENSIONS[i]).c_str());
+        if (alpha->getLength() < 0) {
+            delete alpha;
+        } else {
+            resources.alpha = alpha;
+        }
+    }
+    return resources;
+}
 
-    ERROR:
-    Log::error("Error loading texture into OpenGL.");
-    pResource.close();
-    delete[] rowPtrs;
-    delete[] image;
-    if (pngPtr != NULL) {
-        png_infop *infoPtrP = infoPtr != NULL ? &infoPtr : NULL;
-        png_destroy_read_struct(&pngPtr, infoPtrP, NULL);
+GLuint GraphicsManager::loadCompressedTexture(Resource &pResource,
+                                              int32_t &pWidth, int32_t &pHeight) {
+    CompressedResources &resources = findCompressedResources(pResource);
+    if (resources.color == NULL) return 0;
+
+    GLuint texture = uploadCompressedTexture(*resources.color, pWidth, pHeight);
+    if ((texture != 0) && (resources.alpha != NULL)) {
+        int32_t alphaWidth, alphaHeight;
+        GLuint alphaTexture = uploadCompressedTexture(*resources.alpha, alphaWidth, alphaHeight);
+        if ((alphaTexture != 0) && (alphaWidth == pWidth) && (alphaHeight == pHeight)) {
+            mAlphaTextures[texture] = alphaTexture;
+        } else {
+            glDeleteTextures(1, &alphaTexture);
+            glDeleteTextures(1, &texture);
+            texture = 0;
+        }
     }
-    return NULL;
+    if (texture == 0) {
+        Log::warn("Cannot use compressed %s, decoding %s instead.",
+                  resources.color->getPath(), pResource.getPath());
+    }
+    return texture;
+}
+
+GLuint GraphicsManager::uploadCompressedTexture(Resource &pResource,
+                                                int32_t &pWidth, int32_t &pHeight) {
+    CompressedImage image;
+    if (ImageDecoder::readCompressed(pResource, image) != STATUS_OK) return 0;
+
+    //ETC2 decoders read ETC1 blocks as well.
+    GLenum format = image.format;
+    if ((format == GL_ETC1_RGB8_OES) && !mCompressedETC1 && mCompressedETC2) {
+        format = GL_COMPRESSED_RGB8_ETC2;
+    }
+    if ((format == GL_ETC1_RGB8_OES) ? !mCompressedETC1 : !mCompressedETC2) {
+        pResource.unmap();
+        return 0;
+    }
+
+    //Mip levels are only sampled when the chain is complete.
+    int32_t levelCount = image.levelCount;
+    if (levelCount != ImageDecoder::getMaxLevelCount(image.width, image.height)) {
+        levelCount = 1;
+    }
+    GLuint texture = createTexture();
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                    (levelCount > 1) ? GL_NEAREST_MIPMAP_NEAREST : GL_NEAREST);
+    for (int32_t level = 0; level < levelCount; ++level) {
+        glCompressedTexImage2D(GL_TEXTURE_2D, level, format,
+                               std::max(image.width >> level, 1),
+                               std::max(image.height >> level, 1), 0,
+                               image.levelSizes[level], image.levels[level]);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    pResource.unmap();
+
+    if (glGetError() != GL_NO_ERROR) {
+        glDeleteTextures(1, &texture);
+        return 0;
+    }
+    Log::info("Compressed texture size: %d x %d", image.width, image.height);
+    pWidth = image.width;
+    pHeight = image.height;
+    return texture;
+}
+
+GLuint GraphicsManager::getAlphaTexture(GLuint pTexture) {
+    std::map<GLuint, GLuint>::iterator alphaTextureIt = mAlphaTextures.find(pTexture);
+    return (alphaTextureIt != mAlphaTextures.end()) ? alphaTextureIt->second : 0;
 }
 
 GLuint GraphicsManager::loadShader(const char *pVertexShader, const char *pFragmentShader) {
     GLint result;
     char log[256];
-    GLuint vertexShader, fragmentShader, shaderProgram;
+    GLuint vertexShader = 0, fragmentShader = 0, shaderProgram;
+    uint64_t programKey = 0;
+
+    //Reuses the binary linked by a previous activation or run.
+    if (mProgramBinary != NULL) {
+        programKey = mProgramCache.getKey(pVertexShader, pFragmentShader);
+        shaderProgram = loadProgramBinary(programKey);
+        if (shaderProgram != 0) {
+            mShaders.push_back(shaderProgram);
+            return shaderProgram;
+        }
+    }
 
     //Builds the vertex shader.
     vertexShader = glCreateShader(GL_VERTEX_SHADER); //Create a shader
@@ -466,6 +807,7 @@ GLuint GraphicsManager::loadShader(const char *pVertexShader, const char *pFragm
         goto ERROR;
     }
 
+    if (mProgramBinary != NULL) saveProgramBinary(programKey, shaderProgram);
     mShaders.push_back(shaderProgram);
     return shaderProgram;
 
@@ -476,7 +818,54 @@ GLuint GraphicsManager::loadShader(const char *pVertexShader, const char *pFragm
     return 0;
 }
 
+GLuint GraphicsManager::loadProgramBinary(uint64_t pKey) {
+    const ProgramCache::Binary *binary = mProgramCache.find(pKey);
+    if (binary == NULL) return 0;
+
+    GLint result;
+    GLuint shaderProgram = glCreateProgram();
+    mProgramBinary(shaderProgram, binary->format, &binary->data[0], binary->data.size());
+    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &result);
+    if (result == GL_FALSE) {
+        //E.g. after a driver update: built again from sources.
+        Log::warn("Program binary rejected, compiling shaders.");
+        glDeleteProgram(shaderProgram);
+        mProgramCache.remove(pKey);
+        return 0;
+    }
+    return shaderProgram;
+}
+
+void GraphicsManager::saveProgramBinary(uint64_t pKey, GLuint pShaderProgram) {
+    GLint length = 0;
+    GLsizei writtenLength = 0;
+    glGetProgramiv(pShaderProgram, GL_PROGRAM_BINARY_LENGTH_OES, &length);
+    if (length <= 0) return;
+
+    ProgramCache::Binary binary;
+    binary.format = 0;
+    binary.data.resize(length);
+    mGetProgramBinary(pShaderProgram, length, &writtenLength, &binary.format, &binary.data[0]);
+    if ((glGetError() != GL_NO_ERROR) || (writtenLength <= 0)) return;
+    binary.data.resize(writtenLength);
+    mProgramCache.insert(pKey, binary);
+}
+
 GLuint GraphicsManager::loadVertexBuffer(const void *pVertexBuffer, int32_t pVertexBufferSize) {
+    return loadBuffer(GL_ARRAY_BUFFER, pVertexBuffer, pVertexBufferSize, GL_STATIC_DRAW);
+}
+
+GLuint GraphicsManager::loadIndexBuffer(const void *pIndexBuffer, int32_t pIndexBufferSize) {
+    return loadBuffer(GL_ELEMENT_ARRAY_BUFFER, pIndexBuffer, pIndexBufferSize, GL_STATIC_DRAW);
+}
+
+GLuint GraphicsManager::loadStreamBuffer(int32_t pVertexBufferSize) {
+    //Storage only, respecified by its user each time it is drawn.
+    return loadBuffer(GL_ARRAY_BUFFER, NULL, pVertexBufferSize, GL_STREAM_DRAW);
+}
+
+GLuint GraphicsManager::loadBuffer(GLenum pTarget, const void *pBuffer, int32_t pBufferSize,
+                                   GLenum pUsage) {
     GLuint vertexBuffer;
     //Upload specified memory buffer into OpenGL;
     glGenBuffers(1,
@@ -485,16 +874,16 @@ GLuint GraphicsManager::loadVertexBuffer(const void *pVertexBuffer, int32_t pVer
     //No buffer objects are associated with the returned buffer object names until they are first bound by calling glBindBuffer.
 
 
-    glBindBuffer(GL_ARRAY_BUFFER,
+    glBindBuffer(pTarget,
                  vertexBuffer); //glBindBuffer binds a buffer object to the specified buffer binding point. Calling glBindBuffer with target set to one of the accepted symbolic constants and buffer set to the name of a buffer object binds that buffer object name to the target. If no buffer object with name buffer exists, one is created with that name. When a buffer object is bound to a target, the previous binding for that target is automatically broken.
-    glBufferData(GL_ARRAY_BUFFER, pVertexBufferSize, pVertexBuffer,
-                 GL_STATIC_DRAW);// Copy data from source to the data store pointed at the ARRAY_BUFFER.
+    glBufferData(pTarget, pBufferSize, pBuffer,
+                 pUsage);// Copy data from source to the data store pointed at the ARRAY_BUFFER.
     // DYNAMIC
     //The data store contents will be modified repeatedly and used many times.
     // DRAW
     //The data store contents are modified by the application, and used as the source for GL drawing and image specification commands.
     //Unbinds the buffer.
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(pTarget, 0);
     if (glGetError() != GL_NO_ERROR) goto ERROR;
 
     mVertexBuffers.push_back(vertexBuffer);
@@ -0,0 +1,61 @@
+//
+// Created by cjf12 on 2019-11-18.
+//
+
+#include "include/ImageCache.h"
+#include "include/Log.h"
+
+#include <algorithm>
+
+ImageCache::ImageCache(int64_t pByteBudget) :
+        mByteBudget(pByteBudget), mByteCount(0),
+        mEntries(), mIndex() {
+}
+
+void ImageCache::setByteBudget(int64_t pByteBudget) {
+    mByteBudget = pByteBudget;
+    evict(mByteBudget);
+}
+
+const Image *ImageCache::find(const std::string &pPath) {
+    std::map<std::string, std::list<Entry>::iterator>::iterator indexIt = mIndex.find(pPath);
+    if (indexIt == mIndex.end()) return NULL;
+    //Moves the entry to the front, iterators stay valid.
+    mEntries.splice(mEntries.begin(), mEntries, indexIt->second);
+    return &indexIt->second->image;
+}
+
+void ImageCache::insert(const std::string &pPath, Image &pImage) {
+    int64_t size = pImage.pixels.size();
+    std::map<std::string, std::list<Entry>::iterator>::iterator indexIt = mIndex.find(pPath);
+    if (indexIt != mIndex.end()) {
+        mByteCount -= indexIt->second->image.pixels.size();
+        mEntries.erase(indexIt->second);
+        mIndex.erase(indexIt);
+    }
+    if (size > mByteBudget) return;
+
+    evict(mByteBudget - size);
+    mEntries.push_front(Entry());
+    Entry &entry = mEntries.front();
+    entry.path = pPath;
+    std::swap(entry.image, pImage);
+    mIndex[pPath] = mEntries.begin();
+    mByteCount += size;
+}
+
+void ImageCache::clear() {
+    mEntries.clear();
+    mIndex.clear();
+    mByteCount = 0;
+}
+
+void ImageCache::evict(int64_t pByteBudget) {
+    while ((mByteCount > pByteBudget) && !mEntries.empty()) {
+        Entry &entry = mEntries.back();
+        Log::info("Evicting image %s", entry.path.c_str());
+        mByteCount -= entry.image.pixels.size();
+        mIndex.erase(entry.path);
+        mEntries.pop_back();
+    }
+}
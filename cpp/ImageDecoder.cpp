@@ -0,0 +1,446 @@
+//
+// Created by cjf12 on 2019-11-12.
+//
+
+#include "include/ImageDecoder.h"
+#include "include/Log.h"
+#include "Libraries/libpng/png.h"
+#include <algorithm>
+#include <string.h>
+
+static void callback_readPng(png_structp pStruct, png_bytep pData, png_size_t pSize) {
+    Resource *resource = ((Resource *) png_get_io_ptr(pStruct));
+    if (resource->read(pData, pSize) != STATUS_OK) {
+        png_error(pStruct, "Unexpected end of image");
+    }
+}
+
+int32_t ImageDecoder::getPixelSize(GLint pFormat) {
+    switch (pFormat) {
+        case GL_RGBA:
+            return 4;
+        case GL_RGB:
+            return 3;
+        case GL_LUMINANCE_ALPHA:
+            return 2;
+        default:
+            return 1;
+    }
+}
+
+int64_t ImageDecoder::getByteCount(int32_t pWidth, int32_t pHeight, GLint pFormat,
+                                   int32_t pLevelCount) {
+    int64_t byteCount = 0;
+    for (int32_t level = 0; level < pLevelCount; ++level) {
+        byteCount += int64_t(std::max(pWidth >> level, 1)) * std::max(pHeight >> level, 1);
+    }
+    return byteCount * getPixelSize(pFormat);
+}
+
+int32_t ImageDecoder::getMaxLevelCount(int32_t pWidth, int32_t pHeight) {
+    int32_t levelCount = 1;
+    for (int32_t size = std::max(pWidth, pHeight); size > 1; size >>= 1) {
+        ++levelCount;
+    }
+    return levelCount;
+}
+
+//Whether a resource holds a pre-decoded texture. Leaves it mapped for
+//the decoder which follows.
+static bool isRawTexture(Resource &pResource) {
+    uint32_t magic;
+    if (pResource.map() != STATUS_OK) return false;
+    if (pResource.getLength() < (off_t) sizeof(magic)) return false;
+    memcpy(&magic, pResource.getBuffer(), sizeof(magic));
+    return magic == RAW_TEXTURE_MAGIC;
+}
+
+static bool checkRawTexture(const RawTextureHeader &pHeader) {
+    if ((pHeader.magic != RAW_TEXTURE_MAGIC) || (pHeader.version != RAW_TEXTURE_VERSION))
+        return false;
+    switch (pHeader.format) {
+        case GL_RGBA:
+        case GL_RGB:
+        case GL_LUMINANCE_ALPHA:
+        case GL_LUMINANCE:
+            break;
+        default:
+            return false;
+    }
+    //Beyond any GLES texture size.
+    if ((pHeader.width == 0) || (pHeader.height == 0)
+        || (pHeader.width > 16384) || (pHeader.height > 16384)) return false;
+    return (pHeader.levelCount >= 1)
+           && (int32_t(pHeader.levelCount)
+               <= ImageDecoder::getMaxLevelCount(pHeader.width, pHeader.height));
+}
+
+status ImageDecoder::decode(Resource &pResource, Image &pImage, bool pExpandToRGBA) {
+    if (isRawTexture(pResource)) {
+        return loadRawTexture(pResource, pImage, pExpandToRGBA);
+    } else {
+        return decodePng(pResource, pImage, pExpandToRGBA);
+    }
+}
+
+status ImageDecoder::readSize(Resource &pResource, int32_t &pWidth, int32_t &pHeight) {
+    if (!isRawTexture(pResource)) {
+        return readPngSize(pResource, pWidth, pHeight);
+    }
+
+    RawTextureHeader header;
+    if (pResource.read(&header, sizeof(header)) != STATUS_OK) goto ERROR;
+    if (!checkRawTexture(header)) goto ERROR;
+    pResource.unmap();
+    pWidth = header.width;
+    pHeight = header.height;
+    return STATUS_OK;
+
+    ERROR:
+    Log::error("Error reading texture header %s.", pResource.getPath());
+    pResource.unmap();
+    return STATUS_KO;
+}
+
+status ImageDecoder::loadRawTexture(Resource &pResource, Image &pImage, bool pExpandToRGBA) {
+    RawTextureHeader header;
+    int64_t byteCount;
+    const uint8_t *pixels;
+    int32_t pixelSize, pixelCount;
+
+    if (pResource.map() != STATUS_OK) goto ERROR;
+    if (pResource.read(&header, sizeof(header)) != STATUS_OK) goto ERROR;
+    if (!checkRawTexture(header)) goto ERROR;
+    byteCount = getByteCount(header.width, header.height, header.format, header.levelCount);
+    if (pResource.getLength() != (off_t) (sizeof(header) + byteCount)) goto ERROR;
+    pixels = pResource.getBuffer() + sizeof(header);
+
+    pImage.width = header.width;
+    pImage.height = header.height;
+    if (!pExpandToRGBA) {
+        //Already in upload layout: no conversion at all.
+        pImage.format = header.format;
+        pImage.levelCount = header.levelCount;
+        pImage.pixels.assign(pixels, pixels + byteCount);
+    } else {
+        //Expands the full size level only, as libpng does for PNGs.
+        pixelSize = getPixelSize(header.format);
+        pixelCount = header.width * header.height;
+        pImage.format = GL_RGBA;
+        pImage.levelCount = 1;
+        pImage.pixels.resize(pixelCount * 4);
+        for (int32_t i = 0; i < pixelCount; ++i, pixels += pixelSize) {
+            uint8_t *pixel = &pImage.pixels[i * 4];
+            bool luminance = (header.format == GL_LUMINANCE)
+                             || (header.format == GL_LUMINANCE_ALPHA);
+            pixel[0] = pixels[0];
+            pixel[1] = luminance ? pixels[0] : pixels[1];
+            pixel[2] = luminance ? pixels[0] : pixels[2];
+            pixel[3] = ((pixelSize == 2) || (pixelSize == 4)) ? pixels[pixelSize - 1] : 0xFF;
+        }
+    }
+    pResource.unmap();
+    return STATUS_OK;
+
+    ERROR:
+    Log::error("Error loading texture %s.", pResource.getPath());
+    pResource.unmap();
+    pImage.pixels.clear();
+    return STATUS_KO;
+}
+
+//KTX 1.1 header, in the byte order given by endianness.
+struct KtxHeader {
+    uint8_t identifier[12];
+    uint32_t endianness;
+    uint32_t glType;
+    uint32_t glTypeSize;
+    uint32_t glFormat;
+    uint32_t glInternalFormat;
+    uint32_t glBaseInternalFormat;
+    uint32_t pixelWidth;
+    uint32_t pixelHeight;
+    uint32_t pixelDepth;
+    uint32_t numberOfArrayElements;
+    uint32_t numberOfFaces;
+    uint32_t numberOfMipmapLevels;
+    uint32_t bytesOfKeyValueData;
+};
+
+static const uint8_t KTX_IDENTIFIER[12] = {
+        0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'
+};
+static const int32_t PKM_HEADER_SIZE = 16;
+
+//Bytes per 4 x 4 block, 0 if not a supported format.
+static int32_t getBlockSize(GLenum pFormat) {
+    switch (pFormat) {
+        case GL_ETC1_RGB8_OES:
+        case GL_COMPRESSED_RGB8_ETC2:
+        case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+            return 8;
+        case GL_COMPRESSED_RGBA8_ETC2_EAC:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+static int64_t getCompressedSize(int32_t pWidth, int32_t pHeight, GLenum pFormat) {
+    return int64_t((pWidth + 3) / 4) * ((pHeight + 3) / 4) * getBlockSize(pFormat);
+}
+
+static bool readPkm(const uint8_t *pData, off_t pLength, CompressedImage &pImage) {
+    //Big-endian type, padded size then actual size.
+    int32_t type = (pData[6] << 8) | pData[7];
+    if ((pData[4] == '1') && (pData[5] == '0') && (type == 0)) {
+        pImage.format = GL_ETC1_RGB8_OES;
+    } else if ((pData[4] == '2') && (pData[5] == '0')) {
+        switch (type) {
+            case 0:
+                pImage.format = GL_ETC1_RGB8_OES;
+                break;
+            case 1:
+                pImage.format = GL_COMPRESSED_RGB8_ETC2;
+                break;
+            case 3:
+                pImage.format = GL_COMPRESSED_RGBA8_ETC2_EAC;
+                break;
+            case 4:
+                pImage.format = GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2;
+                break;
+            default:
+                return false;
+        }
+    } else {
+        return false;
+    }
+    pImage.width = (pData[12] << 8) | pData[13];
+    pImage.height = (pData[14] << 8) | pData[15];
+    int64_t size = getCompressedSize(pImage.width, pImage.height, pImage.format);
+    if ((size <= 0) || (pLength - PKM_HEADER_SIZE < size)) return false;
+    pImage.levelCount = 1;
+    pImage.levels[0] = pData + PKM_HEADER_SIZE;
+    pImage.levelSizes[0] = size;
+    return true;
+}
+
+static bool readKtx(const uint8_t *pData, off_t pLength, CompressedImage &pImage) {
+    KtxHeader header;
+    memcpy(&header, pData, sizeof(header));
+    //Only 2D, non-array, compressed textures written in native order.
+    if ((header.endianness != 0x04030201) || (header.glType != 0)
+        || (header.pixelDepth > 1) || (header.numberOfArrayElements > 0)
+        || (header.numberOfFaces != 1)) return false;
+    if ((header.pixelWidth == 0) || (header.pixelHeight == 0)
+        || (header.pixelWidth > 16384) || (header.pixelHeight > 16384)) return false;
+    pImage.format = header.glInternalFormat;
+    pImage.width = header.pixelWidth;
+    pImage.height = header.pixelHeight;
+    pImage.levelCount = std::max(header.numberOfMipmapLevels, uint32_t(1));
+    if ((getBlockSize(pImage.format) == 0)
+        || (pImage.levelCount > MAX_COMPRESSED_LEVELS)
+        || (pImage.levelCount > ImageDecoder::getMaxLevelCount(pImage.width, pImage.height)))
+        return false;
+
+    //Each level is its size then its blocks, padded to 4 bytes.
+    uint64_t offset = sizeof(header) + uint64_t(header.bytesOfKeyValueData);
+    for (int32_t level = 0; level < pImage.levelCount; ++level) {
+        uint32_t imageSize;
+        if (offset + sizeof(imageSize) > uint64_t(pLength)) return false;
+        memcpy(&imageSize, pData + offset, sizeof(imageSize));
+        offset += sizeof(imageSize);
+        if ((imageSize != getCompressedSize(std::max(pImage.width >> level, 1),
+                                            std::max(pImage.height >> level, 1),
+                                            pImage.format))
+            || (offset + imageSize > uint64_t(pLength))) return false;
+        pImage.levels[level] = pData + offset;
+        pImage.levelSizes[level] = imageSize;
+        offset += (imageSize + 3) & ~3u;
+    }
+    return true;
+}
+
+status ImageDecoder::readCompressed(Resource &pResource, CompressedImage &pImage) {
+    const uint8_t *data;
+    off_t length;
+    if (pResource.map() != STATUS_OK) goto ERROR;
+    data = pResource.getBuffer();
+    length = pResource.getLength();
+    if ((length >= PKM_HEADER_SIZE) && (memcmp(data, "PKM ", 4) == 0)) {
+        if (readPkm(data, length, pImage)) return STATUS_OK;
+    } else if ((length >= (off_t) sizeof(KtxHeader))
+               && (memcmp(data, KTX_IDENTIFIER, sizeof(KTX_IDENTIFIER)) == 0)) {
+        if (readKtx(data, length, pImage)) return STATUS_OK;
+    }
+
+    ERROR:
+    Log::error("Error reading compressed texture %s.", pResource.getPath());
+    pResource.unmap();
+    return STATUS_KO;
+}
+
+status ImageDecoder::readPngSize(Resource &pResource, int32_t &pWidth, int32_t &pHeight) {
+    //Signature, then the IHDR chunk length and type, then its width and
+    //height as big-endian 32 bits integers.
+    png_byte header[24];
+    png_uint_32 width, height;
+    if (pResource.map() != STATUS_OK) goto ERROR;
+    if (pResource.read(header, sizeof(header)) != STATUS_OK) goto ERROR;
+    if ((png_sig_cmp(header, 0, 8) != 0) || (memcmp(&header[12], "IHDR", 4) != 0)) goto ERROR;
+    pResource.unmap();
+
+    width = png_get_uint_32(&header[16]);
+    height = png_get_uint_32(&header[20]);
+    if ((width == 0) || (height == 0) || (width > PNG_UINT_31_MAX) || (height > PNG_UINT_31_MAX))
+        goto ERROR;
+    pWidth = width;
+    pHeight = height;
+    return STATUS_OK;
+
+    ERROR:
+    Log::error("Error reading image header %s.", pResource.getPath());
+    pResource.unmap();
+    return STATUS_KO;
+}
+
+status ImageDecoder::decodePng(Resource &pResource, Image &pImage, bool pExpandToRGBA) {
+    GLint format;
+    png_byte header[8];
+    png_structp pngPtr = NULL;
+    png_infop infoPtr = NULL;
+    png_bytep *rowPtrs = NULL;
+    png_int_32 rowSize;
+    bool transparency;
+
+    //Maps the file so that libpng reads from the page cache
+    //without going through stream buffers.
+    if (pResource.map() != STATUS_OK) goto ERROR;
+    Log::info("Checking signature.");
+    if (pResource.read(header, sizeof(header)) != STATUS_OK) goto ERROR;
+    if (png_sig_cmp(header, 0, 8) != 0)
+        goto ERROR;  //png_sig_cmp() checks whether the given number of bytes match the PNG signature starting from the start position. The function shall return non-zero if num_to_check == 0 or start > 7.
+
+    Log::info("Creating required structures.");
+    pngPtr = png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL, NULL,
+                                    NULL); // allocate and initialize a png_struct structure for reading PNG file
+    if (!pngPtr) goto ERROR;
+    infoPtr = png_create_info_struct(pngPtr); //allocate and initialize a png_info structure
+    if (!infoPtr) goto ERROR;
+
+    //prepare reading operation by setting up a read callback.
+    png_set_read_fn(pngPtr, &pResource,
+                    callback_readPng);  //set user-defined function for reading a PNG stream. png_set_read_fn() sets the read_data_fn as the input function for reading PNG files instead of using standard C I/O stream functions. png_ptr - pointer to input data structure png_struct io_ptr - pointer to user-defined structure containing information about the input functions. This value may be NULL. read_data_fn - pointer to new input function that shall take the following arguments: - a pointer to a png_struct - a pointer to a structure where input data can be stored - 32-bit unsigned int to indicate number of bytes to read The input function should invoke png_error() to handle any fatal errors and png_warning() to handle non-fatal errors.
+    //Set up error management. If an error occurs while reading.
+    // code will come back here and jump
+    if (setjmp(png_jmpbuf(pngPtr))) goto ERROR;
+
+    //Ignores first 8 bytes already read.
+    png_set_sig_bytes(pngPtr,
+                      8); //png_set_sig_bytes() shall store the number of bytes of the PNG file signature that have been read from the PNG stream.
+
+    // Retrieved PNG info and updates PNG struct accordingly.
+    png_int_32 depth, colorType;
+    png_uint_32 width, height;
+    png_read_info(pngPtr,
+                  infoPtr); //Reads the information before the actual image data from the PNG file. The function allows reading a file that already has the PNG signature bytes read from the stream.
+    png_get_IHDR(pngPtr, infoPtr, &width, &height, &depth, &colorType, NULL, NULL,
+                 NULL); //png_get_IHDR() gets PNG_IHDR chunk type information from png_info structure.
+
+    //Creates a full alpha channel if transparency is encoded as
+    //an array of palette entries or a single transparent color.
+    transparency = false;
+    if (png_get_valid(pngPtr, infoPtr,
+                      PNG_INFO_tRNS)) { //determine if given chunk data is valid (PNG_INFO_tRNS means transparency data for images)
+        png_set_tRNS_to_alpha(
+                pngPtr); // png_set_tRNS_to_alpha() shall set transformation in png_ptr such that tRNS chunks are expanded to alpha channels.
+        transparency = true;
+    }
+
+    //Expands PNG with less than 8bits per channel to 8 bits.
+    if (depth < 8) {
+        png_set_packing(
+                pngPtr); //png_set_packing() shall expand image to 1 pixel per byte for bit-depths 1, 2 and 4 without changing the order of the pixels. If png_set_packing() is not called, PNG files pack pixels of bit_depths 1, 2 and 4 into bytes as small as possible, for example, 8 pixels per byte for 1-bit files.
+        //Shrinks PNG with 16 bits per color channel down to 8 bits.
+    } else if (depth == 16) {
+        png_set_strip_16(
+                pngPtr); //png_set_strip_16() shall strip the pixels of a PNG stream with 16 bits per channel to 8 bits per channel.
+    }
+
+    //Indicates that image needs conversion to TGBA if needed.
+    switch (colorType) {
+        case PNG_COLOR_TYPE_PALETTE:
+            png_set_palette_to_rgb(
+                    pngPtr); //png_set_palette_to_rgb() shall set transformation in png_ptr such that paletted images are expanded to RGB
+            format = transparency ? GL_RGBA : GL_RGB;
+            break;
+        case PNG_COLOR_TYPE_RGB:
+            format = transparency ? GL_RGBA : GL_RGB;
+            break;
+        case PNG_COLOR_TYPE_RGBA:
+            format = GL_RGBA;
+            break;
+        case PNG_COLOR_TYPE_GRAY:
+            png_set_expand_gray_1_2_4_to_8(
+                    pngPtr); // As of libpng version 1.2.9, png_set_expand_gray_1_2_4_to_8() was added.  It expands the sample depth without changing tRNS to alpha.
+            format = transparency ? GL_LUMINANCE_ALPHA : GL_LUMINANCE;
+            break;
+        case PNG_COLOR_TYPE_GA:
+            png_set_expand_gray_1_2_4_to_8(pngPtr);
+            format = GL_LUMINANCE_ALPHA;
+            break;
+    }
+
+    //Converts everything to RGBA when asked, e.g. to merge images.
+    if (pExpandToRGBA && (format != GL_RGBA)) {
+        if ((format == GL_LUMINANCE) || (format == GL_LUMINANCE_ALPHA)) {
+            png_set_gray_to_rgb(pngPtr); //png_set_gray_to_rgb() expands gray samples to RGB triplets.
+        }
+        if ((format == GL_RGB) || (format == GL_LUMINANCE)) {
+            png_set_add_alpha(pngPtr, 0xFF, PNG_FILLER_AFTER); //png_set_add_alpha() appends an opaque alpha channel.
+        }
+        format = GL_RGBA;
+    }
+
+    //Validates all transformations.
+    png_read_update_info(pngPtr,
+                         infoPtr); //png_read_update_info() updates the structure pointed to by info_ptr to reflect any transformations that have been requested. For example, row bytes will be updated to handle expansion of an interlaced image with png_read_update_info().
+
+    //Get row size in bytes.
+    rowSize = png_get_rowbytes(pngPtr, infoPtr); //Return number of bytes for a row
+    if (rowSize <= 0) goto ERROR;
+    //Creates the image buffer that will be sent to OpenGL.
+    pImage.pixels.resize(rowSize * height);
+    //Pointers to each row of the image buffer. Row order is
+    // inverted becase different coordinate system are used by
+    //OpenGL (1st pixel is at bottom left) and PNGs(top left).
+    rowPtrs = new png_bytep[height];
+    if (!rowPtrs) goto ERROR;
+    for (int i = 0; i < height; ++i) {
+        rowPtrs[height - (i + 1)] = &pImage.pixels[0] + i * rowSize; //the index is reversed?!
+    }
+
+    //Reads image content.
+    png_read_image(pngPtr, rowPtrs); // read the entire image into memory
+    //Free memory and resources.
+    pResource.unmap();
+    png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
+    delete[] rowPtrs; //free the memory associated with read png_struct
+
+    pImage.width = width;
+    pImage.height = height;
+    pImage.format = format;
+    pImage.levelCount = 1;
+    return STATUS_OK;
+
+    ERROR:
+    Log::error("Error decoding image %s.", pResource.getPath());
+    pResource.unmap();
+    delete[] rowPtrs;
+    pImage.pixels.clear();
+    if (pngPtr != NULL) {
+        png_infop *infoPtrP = infoPtr != NULL ? &infoPtr : NULL;
+        png_destroy_read_struct(&pngPtr, infoPtrP, NULL);
+    }
+    return STATUS_KO;
+}
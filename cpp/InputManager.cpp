@@ -14,7 +14,7 @@ InputManager::InputManager(android_app *pApplication,
         mGraphicsManager(pGraphicsManager),
         mDirectionX(0.0f),
         mDirectionY(0.0f),
-        mRefPoint(NULL) {
+        mRefBodyStates(NULL), mRefBodyIndex(-1) {
     Configuration configuration(pApplication);
     mRotation = configuration.getRotation();
 
@@ -31,7 +31,7 @@ void InputManager::start() {
 bool InputManager::onTouchEvent(AInputEvent *pEvent) {
     static const float TOUCH_MAX_RANGE = 65.0f; //in game units;
 
-    if (mRefPoint != NULL) {
+    if (mRefBodyStates != NULL) {
         /* Get the combined motion event action code and pointer index. */
         if (AMotionEvent_getAction(pEvent) == AMOTION_EVENT_ACTION_MOVE) {
             /*
@@ -48,8 +48,10 @@ bool InputManager::onTouchEvent(AInputEvent *pEvent) {
 
             //Needs a conversion to proper coordinates
             // (origin at bottom/left). Only moveY needs it.
-            float moveX = x - mRefPoint->x;
-            float moveY = y - mRefPoint->y;
+            //Read from the state table, up to date as soon as physics
+            //stepped, rather than from a sprite refreshed when drawn.
+            float moveX = x - mRefBodyStates->x[mRefBodyIndex];
+            float moveY = y - mRefBodyStates->y[mRefBodyIndex];
             float moveRange = sqrt((moveX * moveX) + (moveY * moveY));
 
             if (moveRange > TOUCH_MAX_RANGE) {
@@ -0,0 +1,219 @@
+//
+// Created by cjf12 on 2019-11-09.
+//
+
+#include "include/KinematicBodies.h"
+
+#include <algorithm>
+#include <math.h>
+
+//Cells along the largest dimension of the bounds.
+static const int32_t GRID_DIVISIONS = 16;
+
+KinematicBodies::KinematicBodies(float pScale) :
+        slot(), x(), y(), velocityX(), velocityY(), radius(), category(), mask(),
+        mScale(pScale),
+        mLeft(0.0f), mBottom(0.0f), mCellSize(1.0f), mColumns(1), mRows(1),
+        mMaxRadius(0.0f), mCategories(0), mMasks(0),
+        mCellStart(2, 0), mCellCursor(1, 0), mCellBodies(),
+        mProbes(), mOverlaps(), mPreviousOverlaps() {
+}
+
+void KinematicBodies::setBounds(float pLeft, float pBottom, float pRight, float pTop) {
+    float width = pRight - pLeft, height = pTop - pBottom;
+    mLeft = pLeft;
+    mBottom = pBottom;
+    mCellSize = std::max(width, height) / GRID_DIVISIONS;
+    if (mCellSize <= 0.0f) mCellSize = 1.0f;
+    mColumns = std::max(1, int32_t(ceilf(width / mCellSize)));
+    mRows = std::max(1, int32_t(ceilf(height / mCellSize)));
+    mCellStart.assign(mColumns * mRows + 1, 0);
+    mCellCursor.assign(mColumns * mRows, 0);
+}
+
+int32_t KinematicBodies::add(int32_t pSlot, uint16_t pCategory, uint16_t pMask, float pRadius) {
+    int32_t index = size();
+    slot.push_back(pSlot);
+    x.push_back(0.0f);
+    y.push_back(0.0f);
+    velocityX.push_back(0.0f);
+    velocityY.push_back(0.0f);
+    radius.push_back(pRadius);
+    category.push_back(pCategory);
+    mask.push_back(pMask);
+    mCellBodies.push_back(0);
+
+    mMaxRadius = std::max(mMaxRadius, pRadius);
+    mCategories |= pCategory;
+    mMasks |= pMask;
+    return index;
+}
+
+void KinematicBodies::addProbe(int32_t pSlot, uint16_t pCategory, uint16_t pMask, float pRadius,
+                               float pX, float pY, float pVelocityX, float pVelocityY) {
+    Probe probe;
+    probe.slot = pSlot;
+    probe.category = pCategory;
+    probe.mask = pMask;
+    probe.radius = pRadius;
+    probe.x = pX;
+    probe.y = pY;
+    probe.velocityX = pVelocityX;
+    probe.velocityY = pVelocityY;
+    mProbes.push_back(probe);
+}
+
+int32_t KinematicBodies::cellX(float pX) const {
+    int32_t cell = int32_t(floorf((pX - mLeft) / mCellSize));
+    return (cell < 0) ? 0 : ((cell >= mColumns) ? mColumns - 1 : cell);
+}
+
+int32_t KinematicBodies::cellY(float pY) const {
+    int32_t cell = int32_t(floorf((pY - mBottom) / mCellSize));
+    return (cell < 0) ? 0 : ((cell >= mRows) ? mRows - 1 : cell);
+}
+
+void KinematicBodies::buildGrid() {
+    int32_t count = size();
+    int32_t cellCount = mColumns * mRows;
+    int32_t *cellStart = &mCellStart[0];
+    int32_t *cellCursor = &mCellCursor[0];
+    std::fill(cellStart, cellStart + cellCount + 1, 0);
+
+    //Counts bodies per cell, shifted by one so that the prefix sum below
+    //gives the first entry of each cell.
+    for (int i = 0; i < count; ++i) {
+        ++cellStart[cellY(y[i]) * mColumns + cellX(x[i]) + 1];
+    }
+    for (int i = 0; i < cellCount; ++i) {
+        cellStart[i + 1] += cellStart[i];
+        cellCursor[i] = cellStart[i];
+    }
+    for (int i = 0; i < count; ++i) {
+        mCellBodies[cellCursor[cellY(y[i]) * mColumns + cellX(x[i])]++] = i;
+    }
+}
+
+void KinematicBodies::query(const Probe &pProbe, int32_t pFirst) {
+    //Any body overlapping the probe has its center within this range.
+    float reach = pProbe.radius + mMaxRadius;
+    int32_t fromX = cellX(pProbe.x - reach), toX = cellX(pProbe.x + reach);
+    int32_t fromY = cellY(pProbe.y - reach), toY = cellY(pProbe.y + reach);
+
+    for (int cy = fromY; cy <= toY; ++cy) {
+        for (int cx = fromX; cx <= toX; ++cx) {
+            int32_t cell = cy * mColumns + cx;
+            for (int e = mCellStart[cell]; e < mCellStart[cell + 1]; ++e) {
+                int32_t i = mCellBodies[e];
+                if (i <= pFirst) continue;
+                if (((category[i] & pProbe.mask) == 0) || ((pProbe.category & mask[i]) == 0)) {
+                    continue;
+                }
+                float dx = x[i] - pProbe.x, dy = y[i] - pProbe.y;
+                float distance = pProbe.radius + radius[i];
+                float distanceSq = dx * dx + dy * dy;
+                if (distanceSq >= distance * distance) continue;
+
+                //Same conventions as Box2D contacts: normal from A to B,
+                //approach speed positive when closing in.
+                float length = sqrtf(distanceSq);
+                float normalX = (length > 0.0f) ? dx / length : 0.0f;
+                float normalY = (length > 0.0f) ? dy / length : 1.0f;
+
+                Overlap overlap;
+                ContactEvent &event = overlap.event;
+                bool probeFirst = pProbe.slot < slot[i];
+                overlap.key = probeFirst
+                              ? (uint64_t(pProbe.slot) << 32) | uint32_t(slot[i])
+                              : (uint64_t(slot[i]) << 32) | uint32_t(pProbe.slot);
+                event.type = ContactEvent::BEGIN;
+                event.bodyA = pProbe.slot;
+                event.bodyB = slot[i];
+                event.categoryA = pProbe.category;
+                event.categoryB = category[i];
+                event.approachSpeed = -((velocityX[i] - pProbe.velocityX) * normalX
+                                        + (velocityY[i] - pProbe.velocityY) * normalY) * mScale;
+                event.x = (pProbe.x + normalX * pProbe.radius) * mScale;
+                event.y = (pProbe.y + normalY * pProbe.radius) * mScale;
+                mOverlaps.push_back(overlap);
+            }
+        }
+    }
+}
+
+void KinematicBodies::step(float pTimeStep, ContactEventQueue &pContacts) {
+    int32_t count = size();
+    if (count == 0) {
+        mProbes.clear();
+        return;
+    }
+
+    float *positionsX = &x[0], *positionsY = &y[0];
+    const float *velocitiesX = &velocityX[0], *velocitiesY = &velocityY[0];
+    for (int i = 0; i < count; ++i) {
+        positionsX[i] += velocitiesX[i] * pTimeStep;
+        positionsY[i] += velocitiesY[i] * pTimeStep;
+    }
+
+    buildGrid();
+    mPreviousOverlaps.swap(mOverlaps);
+    mOverlaps.clear();
+    for (std::vector<Probe>::const_iterator probeIt = mProbes.begin();
+         probeIt < mProbes.end(); ++probeIt) {
+        query(*probeIt, -1);
+    }
+    mProbes.clear();
+    //Kinematic pairs are only searched when some can collide together,
+    //each pair once.
+    if ((mCategories & mMasks) != 0) {
+        for (int i = 0; i < count; ++i) {
+            Probe probe;
+            probe.slot = slot[i];
+            probe.category = category[i];
+            probe.mask = mask[i];
+            probe.radius = radius[i];
+            probe.x = x[i];
+            probe.y = y[i];
+            probe.velocityX = velocityX[i];
+            probe.velocityY = velocityY[i];
+            query(probe, i);
+        }
+    }
+
+    //Reports the difference with the previous step: new pairs begin,
+    //missing ones end.
+    std::sort(mOverlaps.begin(), mOverlaps.end());
+    std::vector<Overlap>::const_iterator current = mOverlaps.begin();
+    std::vector<Overlap>::const_iterator previous = mPreviousOverlaps.begin();
+    while ((current < mOverlaps.end()) || (previous < mPreviousOverlaps.end())) {
+        if ((previous == mPreviousOverlaps.end())
+            || ((current < mOverlaps.end()) && (current->key < previous->key))) {
+            ContactEvent *event = pContacts.append();
+            if (event != NULL) {
+                *event = current->event;
+            } else {
+                pContacts.markDropped(current->event.bodyA, current->event.bodyB);
+            }
+            ++current;
+        } else if ((current == mOverlaps.end()) || (previous->key < current->key)) {
+            ContactEvent *event = pContacts.append();
+            if (event != NULL) {
+                *event = previous->event;
+                event->type = ContactEvent::END;
+                event->approachSpeed = 0.0f;
+            }
+            ++previous;
+        } else {
+            ++current;
+            ++previous;
+        }
+    }
+}
+
+void KinematicBodies::cachePositions(std::vector<float> &pX, std::vector<float> &pY) const {
+    int32_t count = size();
+    for (int i = 0; i < count; ++i) {
+        pX[slot[i]] = x[i] * mScale;
+        pY[slot[i]] = y[i] * mScale;
+    }
+}
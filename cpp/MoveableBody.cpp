@@ -20,12 +20,15 @@ MoveableBody::MoveableBody(android_app *pApplication,
 }
 
 b2Body *
-MoveableBody::registerMoveableBody(Location &pLocation, int32_t pSizeX, int32_t pSizeY) {
+MoveableBody::registerMoveableBody(Sprite *pGraphics, int32_t pSizeX, int32_t pSizeY) {
     //the space ship is cat 2, will collide with cat 1 objects
-    mBody = mPhysicsManager.loadBody(pLocation, 0x2, 0x1, pSizeX, pSizeY, 0.0f);
+    mBody = mPhysicsManager.loadBody(0x2, 0x1, pSizeX, pSizeY, 0.0f);
+    int32_t bodyIndex = mPhysicsManager.getBodyIndex(mBody);
+    pGraphics->bindBody(&mPhysicsManager.getBodyStates(), bodyIndex);
     //define the ship is move towards a mouse anchor point. The touch point is like a imaginary object that the ship is joint.
     mTarget = mPhysicsManager.loadTarget(mBody);
-    mInputManager.setRefPoint(&pLocation);
+    //Touches are relative to the body state of the current frame.
+    mInputManager.setRefPoint(&mPhysicsManager.getBodyStates(), bodyIndex);
     return mBody;
 }
 
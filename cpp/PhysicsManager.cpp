@@ -13,17 +13,48 @@
 
 static const int32_t VELOCITY_ITER = 6;
 static const int32_t POSITION_ITER = 2;
+//Contacts recorded per frame before dropping.
+static const int32_t CONTACT_EVENT_CAPACITY = 256;
+
+//Copies body positions, in render units, into contiguous arrays. Slots of
+//kinematic bodies have no Box2D body.
+static void cacheBodyPositions(std::vector<b2Body *> &pBodies,
+                               std::vector<float> &pX, std::vector<float> &pY) {
+    int32_t size = pBodies.size();
+    if (size == 0) return;
+    b2Body **bodies = &pBodies[0];
+    float *positionsX = &pX[0];
+    float *positionsY = &pY[0];
+    for (int i = 0; i < size; ++i) {
+        if (bodies[i] == NULL) continue;
+        const b2Vec2 &position = bodies[i]->GetPosition();
+        positionsX[i] = position.x * PHYSICS_SCALE;
+        positionsY[i] = position.y * PHYSICS_SCALE;
+    }
+}
 
 PhysicsManager::PhysicsManager(TimeManager &pTimeManager, GraphicsManager &pGraphicsManager) :
         mTimeManager(pTimeManager), mGraphicsManager(pGraphicsManager),
         mWorld(b2Vec2_zero), mBodies(),
-        mLocations(),
+        mBodyStates(), mCollisions(), mFreeBodies(),
+        mContactEvents(CONTACT_EVENT_CAPACITY),
+        mKinematicBodies(PHYSICS_SCALE),
+        mFixedTimeStep(0.0f), mMaxSubSteps(1), mAccumulator(0.0f), mStepCount(0),
         mBoundsBodyObj(NULL) {
     Log::info("Creating PhysicsManager.");
     mWorld.SetContactListener(this);
 }
 
+void PhysicsManager::setFixedTimeStep(float pFrequency, int32_t pMaxSubSteps) {
+    mFixedTimeStep = (pFrequency > 0.0f) ? 1.0f / pFrequency : 0.0f;
+    mMaxSubSteps = (pMaxSubSteps > 0) ? pMaxSubSteps : 1;
+    mAccumulator = 0.0f;
+}
+
 void PhysicsManager::start() {
+    mAccumulator = 0.0f;
+    mKinematicBodies.setBounds(0.0f, 0.0f, mGraphicsManager.getRenderWidth() / PHYSICS_SCALE,
+                               mGraphicsManager.getRenderHeight() / PHYSICS_SCALE);
     if (mBoundsBodyObj == NULL) {
         //define the boundary object for the world?
 
@@ -64,10 +95,75 @@ void PhysicsManager::start() {
     }
 }
 
-b2Body *PhysicsManager::loadBody(Location &pLocation,
-                                 uint16 pCategory, uint16 pMask, int32_t pSizeX, int32_t pSizeY,
+void PhysicsManager::reserveBodies(int32_t pCount) {
+    //Bodies are pushed in reverse so that loadBody() hands out slots in
+    //ascending order, keeping the state table walked front to back.
+    int32_t first = mBodies.size();
+    mFreeBodies.reserve(mFreeBodies.size() + pCount);
+    for (int i = 0; i < pCount; ++i) {
+        createBody();
+    }
+    for (int i = first + pCount - 1; i >= first; --i) {
+        mFreeBodies.push_back(i);
+    }
+}
+
+b2Body *PhysicsManager::loadBody(uint16 pCategory, uint16 pMask, int32_t pSizeX, int32_t pSizeY,
                                  float pRestitution) {
-    PhysicsCollision *userData = new PhysicsCollision();
+    //Recycles a released or reserved body when available: a body is only
+    //created (and its slot allocated) when the pool is empty.
+    b2Body *mBodyObj;
+    if (!mFreeBodies.empty()) {
+        mBodyObj = mBodies[mFreeBodies.back()];
+        mFreeBodies.pop_back();
+    } else {
+        mBodyObj = createBody();
+    }
+
+    b2Fixture *fixture = mBodyObj->GetFixtureList();
+    int32_t diameter = (pSizeX + pSizeY) / 2; //the diameter
+    fixture->GetShape()->m_radius = diameter / (2.0f * PHYSICS_SCALE); //the radius of the circle shape
+    fixture->SetRestitution(pRestitution); // The restitution (elasticity) usually in the range [0,1].
+
+    //Each body is assigned one or more category (each being
+    //represented by one bit in a short integer, the categoryBits member) and a mask
+    //describing categories of the body they can collide with (each filtered category being
+    //represented by a bit set to 0, the maskBits member), as shown in the following figure:
+    b2Filter filter;
+    filter.categoryBits = pCategory; // The collision category bits. Normally you would just set one bit.
+    filter.maskBits = pMask; //the category that this fixture interacts with.
+    fixture->SetFilterData(filter);
+
+    //Mass depends on the radius.
+    mBodyObj->ResetMassData();
+    mBodyObj->SetLinearVelocity(b2Vec2_zero);
+    mBodyObj->SetActive(true);
+    return mBodyObj;
+}
+
+void PhysicsManager::releaseBody(b2Body *pBody) {
+    //Deactivated bodies leave the broad-phase and stop colliding but keep
+    //their fixture, user data and state slot for the next loadBody().
+    //Like any body change, must not happen during a world step.
+    //Pooled bodies are exactly the inactive ones: releasing one twice
+    //would hand it out to two owners.
+    int32_t index = ((pBody != NULL) && (pBody->GetUserData() != NULL))
+                    ? getBodyIndex(pBody) : -1;
+    if ((index < 0) || (index >= int32_t(mBodies.size())) || (mBodies[index] != pBody)
+        || !pBody->IsActive()) {
+        Log::error("Cannot release body %d", index);
+        return;
+    }
+    pBody->SetActive(false);
+    mFreeBodies.push_back(index);
+}
+
+b2Body *PhysicsManager::createBody() {
+    //Reserves the body slot in the state table. The slot index follows
+    //mBodies so both can be walked in lockstep. User data lives in a deque
+    //so its address stays valid as the pool grows.
+    mCollisions.push_back(PhysicsCollision(mBodyStates.add()));
+    PhysicsCollision *userData = &mCollisions.back();
 
     b2BodyDef mBodyDef;
     b2Body *mBodyObj;
@@ -79,34 +175,39 @@ b2Body *PhysicsManager::loadBody(Location &pLocation,
     mBodyDef.userData = userData; //the collision record
     mBodyDef.awake = true; // dynamic: positive mass, non-zero velocity determined by forces, moved by solver
     mBodyDef.fixedRotation = true; // Should this body be prevented from rotating? Useful for characters.
+    mBodyDef.active = false; //activated by loadBody()
 
+    //Shape size, filter and restitution are set by loadBody().
     mShapeDef.m_p = b2Vec2_zero; //the position
-    int32_t diameter = (pSizeX + pSizeY) / 2; //the diameter
-    mShapeDef.m_radius = diameter / (2.0f * PHYSICS_SCALE); //the radius of the circle shape
+    mShapeDef.m_radius = 1.0f;
 
     /// A fixture definition is used to create a fixture. This class defines an
     /// abstract fixture definition. You can reuse fixture definitions safely.
     mFixtureDef.shape = &mShapeDef;  // A fixture definition is used to create a fixture. This class defines an abstract fixture definition. You can reuse fixture definitions safely.
     mFixtureDef.density = 1.0f; // The density, usually in kg/m^2.
     mFixtureDef.friction = 0.0f; // The friction coefficient, usually in the range [0,1].
-    mFixtureDef.restitution = pRestitution; // The restitution (elasticity) usually in the range [0,1].
-
-    //Each body is assigned one or more category (each being
-    //represented by one bit in a short integer, the categoryBits member) and a mask
-    //describing categories of the body they can collide with (each filtered category being
-    //represented by a bit set to 0, the maskBits member), as shown in the following figure:
-    mFixtureDef.filter.categoryBits = pCategory; // The collision category bits. Normally you would just set one bit.
-    mFixtureDef.filter.maskBits = pMask; //the category that this fixture interacts with.
     mFixtureDef.userData = userData; //the collision data
 
     mBodyObj = mWorld.CreateBody(&mBodyDef);
     mBodyObj->CreateFixture(&mFixtureDef); //create a fixture associate with this body.
     mBodyObj->SetUserData(userData);
-    mLocations.push_back(&pLocation);
     mBodies.push_back(mBodyObj);
     return mBodyObj;
 }
 
+int32_t PhysicsManager::loadKinematicBody(uint16 pCategory, uint16 pMask,
+                                          int32_t pSizeX, int32_t pSizeY) {
+    //Takes a state slot like any body, without Box2D counterpart.
+    int32_t slot = mBodyStates.add();
+    mBodies.push_back(NULL);
+    int32_t diameter = (pSizeX + pSizeY) / 2;
+    return mKinematicBodies.add(slot, pCategory, pMask, diameter / (2.0f * PHYSICS_SCALE));
+}
+
+int32_t PhysicsManager::getBodyIndex(b2Body *pBody) {
+    return ((PhysicsCollision *) pBody->GetUserData())->index;
+}
+
 /*Implement the loadTarget() method that creates a Box2D mouse joint to
 simulate spaceship movements. Such a Joint defines an empty target toward
 which the body (here specified in parameter) moves, like a kind of elastic. The
@@ -135,44 +236,134 @@ b2MouseJoint *PhysicsManager::loadTarget(b2Body *pBodyObj) {
     return (b2MouseJoint *) mWorld.CreateJoint(&mouseJointDef);
 }
 
+void PhysicsManager::step(float pTimeStep) {
+    //Take a time step.
+    mWorld.Step(pTimeStep, VELOCITY_ITER, POSITION_ITER);
+    if (mKinematicBodies.size() == 0) return;
+
+    //Box2D bodies that may touch a kinematic body are checked against
+    //the spatial hash, after they moved.
+    for (std::vector<b2Body *>::iterator bodyIt = mBodies.begin();
+         bodyIt < mBodies.end(); ++bodyIt) {
+        b2Body *body = *bodyIt;
+        if ((body == NULL) || !body->IsActive()) continue;
+        b2Fixture *fixture = body->GetFixtureList();
+        const b2Filter &filter = fixture->GetFilterData();
+        if (((filter.maskBits & mKinematicBodies.getCategories()) == 0)
+            || ((filter.categoryBits & mKinematicBodies.getMasks()) == 0)) {
+            continue;
+        }
+        const b2Vec2 &position = body->GetPosition();
+        const b2Vec2 &velocity = body->GetLinearVelocity();
+        mKinematicBodies.addProbe(getBodyIndex(body), filter.categoryBits, filter.maskBits,
+                                  fixture->GetShape()->m_radius,
+                                  position.x, position.y, velocity.x, velocity.y);
+    }
+    mKinematicBodies.step(pTimeStep, mContactEvents);
+}
+
+void PhysicsManager::cachePositions(std::vector<float> &pX, std::vector<float> &pY) {
+    cacheBodyPositions(mBodies, pX, pY);
+    mKinematicBodies.cachePositions(pX, pY);
+}
+
 void PhysicsManager::update() {
-    // Clears collision flags.
-    int32_t size = mBodies.size();
-    for (int i = 0; i < size; ++i) {
-        PhysicsCollision *physicsCollision = ((PhysicsCollision *) mBodies[i]->GetUserData());
-        physicsCollision->collide = false;
+    // Contacts are reported for the steps of this frame only.
+    mContactEvents.clear();
+
+    if (mFixedTimeStep <= 0.0f) {
+        //Updates simulation with the frame duration.
+        step(mTimeManager.elapsed());
+        mStepCount = 1;
+
+        //Caches the new state into contiguous position arrays, rendered
+        //as is.
+        cachePositions(mBodyStates.currentX, mBodyStates.currentY);
+        mBodyStates.x = mBodyStates.currentX;
+        mBodyStates.y = mBodyStates.currentY;
+        return;
     }
 
-    //Updates simulation
-    float timeStep = mTimeManager.elapsed();
-    //Take a time step.
-    mWorld.Step(timeStep, VELOCITY_ITER, POSITION_ITER);
+    //Fixed time step mode: consumes elapsed time in constant steps, at
+    //most mMaxSubSteps per frame. Time beyond that is dropped so that a
+    //long frame cannot make the next ones even longer.
+    mAccumulator += mTimeManager.elapsed();
+    int32_t stepCount = int32_t(mAccumulator / mFixedTimeStep);
+    if (stepCount > mMaxSubSteps) {
+        stepCount = mMaxSubSteps;
+        mAccumulator = stepCount * mFixedTimeStep;
+    }
+    mStepCount = stepCount;
 
-    //Caches the new state.
-    for (int i = 0; i < size; ++i) {
-        const b2Vec2 &position = mBodies[i]->GetPosition();
-        mLocations[i]->x = position.x * PHYSICS_SCALE;
-        mLocations[i]->y = position.y * PHYSICS_SCALE;
+    if (stepCount > 0) {
+        for (int i = 0; i < stepCount - 1; ++i) {
+            step(mFixedTimeStep);
+        }
+        //Only the states around the last step are needed to interpolate.
+        //Also picks up bodies teleported by game code since last frame.
+        cachePositions(mBodyStates.previousX, mBodyStates.previousY);
+        step(mFixedTimeStep);
+        cachePositions(mBodyStates.currentX, mBodyStates.currentY);
+        mAccumulator -= stepCount * mFixedTimeStep;
     }
+
+    //Renders bodies part way between the last two physics states.
+    mBodyStates.interpolate(mAccumulator / mFixedTimeStep);
 }
 
 /// The class manages contact between two shapes. A contact exists for each overlapping
 /// AABB in the broad-phase (except if filtered). Therefore a contact object may exist
 /// that has no contact points.
 void PhysicsManager::BeginContact(b2Contact *pContact) {
-    void *userDataA = pContact->GetFixtureA()->GetUserData();
-    void *userDataB = pContact->GetFixtureB()->GetUserData();
-    if (userDataA != NULL && userDataB != NULL) {
-        ((PhysicsCollision *) userDataA)->collide = true;
-        ((PhysicsCollision *) userDataB)->collide = true;
+    recordContact(pContact, ContactEvent::BEGIN);
+}
+
+void PhysicsManager::EndContact(b2Contact *pContact) {
+    recordContact(pContact, ContactEvent::END);
+}
+
+void PhysicsManager::recordContact(b2Contact *pContact, int32_t pType) {
+    b2Fixture *fixtureA = pContact->GetFixtureA();
+    b2Fixture *fixtureB = pContact->GetFixtureB();
+    void *userDataA = fixtureA->GetUserData();
+    void *userDataB = fixtureB->GetUserData();
+    //Ignores contacts with the world boundaries.
+    if (userDataA == NULL || userDataB == NULL) return;
+
+    ContactEvent *event = mContactEvents.append();
+    if (event == NULL) {
+        if (pType == ContactEvent::BEGIN) {
+            mContactEvents.markDropped(((PhysicsCollision *) userDataA)->index,
+                                       ((PhysicsCollision *) userDataB)->index);
+        }
+        return;
     }
+    b2Body *bodyA = fixtureA->GetBody();
+    b2Body *bodyB = fixtureB->GetBody();
+    event->type = pType;
+    event->bodyA = ((PhysicsCollision *) userDataA)->index;
+    event->bodyB = ((PhysicsCollision *) userDataB)->index;
+    event->categoryA = fixtureA->GetFilterData().categoryBits;
+    event->categoryB = fixtureB->GetFilterData().categoryBits;
+
+    //Contact point and closing speed along the normal (pointing from A to
+    //B). Manifold points are only meaningful while touching.
+    b2Vec2 point = 0.5f * (bodyA->GetPosition() + bodyB->GetPosition());
+    float approachSpeed = 0.0f;
+    if ((pType == ContactEvent::BEGIN) && (pContact->GetManifold()->pointCount > 0)) {
+        b2WorldManifold worldManifold;
+        pContact->GetWorldManifold(&worldManifold);
+        point = worldManifold.points[0];
+        b2Vec2 relativeVelocity = bodyB->GetLinearVelocityFromWorldPoint(point)
+                                  - bodyA->GetLinearVelocityFromWorldPoint(point);
+        approachSpeed = -b2Dot(relativeVelocity, worldManifold.normal) * PHYSICS_SCALE;
+    }
+    event->approachSpeed = approachSpeed;
+    event->x = point.x * PHYSICS_SCALE;
+    event->y = point.y * PHYSICS_SCALE;
 }
 
 
 PhysicsManager::~PhysicsManager() {
     Log::info("Destroying PhysicManager.");
-    std::vector<b2Body *>::iterator bodyIt;
-    for (bodyIt = mBodies.begin(); bodyIt < mBodies.end(); ++bodyIt) {
-        delete (PhysicsCollision *) (*bodyIt)->GetUserData();
-    }
 }
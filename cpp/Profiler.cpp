@@ -0,0 +1,40 @@
+//
+// Created by cjf12 on 2019-11-03.
+//
+
+#include "include/Profiler.h"
+#include <time.h>
+
+double Profiler::sLastMark = 0.0;
+double Profiler::sStageTimes[Profiler::STAGE_COUNT] = {0.0};
+
+void Profiler::begin() {
+    for (int i = 0; i < STAGE_COUNT; ++i) {
+        sStageTimes[i] = 0.0;
+    }
+    sLastMark = now();
+}
+
+void Profiler::mark(Profiler::Stage pStage) {
+    double currentTime = now();
+    sStageTimes[pStage] += currentTime - sLastMark;
+    sLastMark = currentTime;
+}
+
+double Profiler::getStageTime(Profiler::Stage pStage) {
+    return sStageTimes[pStage];
+}
+
+const char *Profiler::getStageName(Profiler::Stage pStage) {
+    static const char *names[] = {
+            "TimeManager", "PhysicsManager", "Asteroid", "MoveableBody", "Ship",
+            "GraphicsManager"
+    };
+    return names[pStage];
+}
+
+double Profiler::now() {
+    timespec timeVal;
+    clock_gettime(CLOCK_MONOTONIC, &timeVal);
+    return timeVal.tv_sec + (timeVal.tv_nsec * 1.0e-9);
+}
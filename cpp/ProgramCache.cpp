@@ -0,0 +1,125 @@
+//
+// Created by cjf12 on 2019-11-21.
+//
+
+#include "include/ProgramCache.h"
+#include "include/Log.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const uint32_t PROGRAM_FILE_MAGIC = 0x42504244; // "DBPB"
+static const uint32_t PROGRAM_FILE_VERSION = 1;
+//Beyond any real program binary: such a header is corrupted.
+static const uint32_t MAX_PROGRAM_SIZE = 16 * 1024 * 1024;
+
+struct ProgramFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t format;
+    uint32_t size;
+    uint64_t key;
+};
+
+//64 bits FNV-1a, continued from pHash.
+static uint64_t hash(uint64_t pHash, const char *pString) {
+    for (const uint8_t *c = (const uint8_t *) pString; *c != '\0'; ++c) {
+        pHash = (pHash ^ *c) * 0x100000001b3ULL;
+    }
+    //Separates strings, so that moving text from one to the next
+    //changes the key.
+    return (pHash ^ 0xFF) * 0x100000001b3ULL;
+}
+
+ProgramCache::ProgramCache() :
+        mDirectory(),
+        mDriverHash(0xcbf29ce484222325ULL),
+        mBinaries() {
+}
+
+void ProgramCache::setDirectory(const std::string &pDirectory) {
+    mDirectory = pDirectory;
+    if (!mDirectory.empty() && (mkdir(mDirectory.c_str(), 0700) < 0) && (errno != EEXIST)) {
+        Log::warn("Cannot create program cache %s", mDirectory.c_str());
+        mDirectory.clear();
+    }
+}
+
+void ProgramCache::setDriver(const std::string &pDriver) {
+    mDriverHash = hash(0xcbf29ce484222325ULL, pDriver.c_str());
+}
+
+uint64_t ProgramCache::getKey(const char *pVertexShader, const char *pFragmentShader) {
+    return hash(hash(mDriverHash, pVertexShader), pFragmentShader);
+}
+
+const ProgramCache::Binary *ProgramCache::find(uint64_t pKey) {
+    std::map<uint64_t, Binary>::iterator binaryIt = mBinaries.find(pKey);
+    if (binaryIt != mBinaries.end()) return &binaryIt->second;
+    if (mDirectory.empty()) return NULL;
+
+    ProgramFileHeader header;
+    Binary binary;
+    FILE *file = fopen(getPath(pKey).c_str(), "rb");
+    if (file == NULL) return NULL;
+    bool result = (fread(&header, sizeof(header), 1, file) == 1)
+                  && (header.magic == PROGRAM_FILE_MAGIC)
+                  && (header.version == PROGRAM_FILE_VERSION)
+                  && (header.key == pKey)
+                  && (header.size > 0) && (header.size <= MAX_PROGRAM_SIZE);
+    if (result) {
+        binary.format = header.format;
+        binary.data.resize(header.size);
+        result = (fread(&binary.data[0], header.size, 1, file) == 1);
+    }
+    fclose(file);
+    if (!result) {
+        Log::warn("Ignoring invalid program binary %s", getPath(pKey).c_str());
+        return NULL;
+    }
+
+    Binary &cachedBinary = mBinaries[pKey];
+    cachedBinary.format = binary.format;
+    cachedBinary.data.swap(binary.data);
+    return &cachedBinary;
+}
+
+void ProgramCache::insert(uint64_t pKey, Binary &pBinary) {
+    Binary &binary = mBinaries[pKey];
+    binary.format = pBinary.format;
+    binary.data.swap(pBinary.data);
+    pBinary.data.clear();
+    if (mDirectory.empty() || binary.data.empty()) return;
+
+    //Written aside then renamed, so that an interrupted write never
+    //leaves a truncated binary behind.
+    ProgramFileHeader header;
+    header.magic = PROGRAM_FILE_MAGIC;
+    header.version = PROGRAM_FILE_VERSION;
+    header.format = binary.format;
+    header.size = binary.data.size();
+    header.key = pKey;
+    std::string path = getPath(pKey), temporaryPath = path + ".tmp";
+    FILE *file = fopen(temporaryPath.c_str(), "wb");
+    if (file == NULL) return;
+    bool result = (fwrite(&header, sizeof(header), 1, file) == 1)
+                  && (fwrite(&binary.data[0], binary.data.size(), 1, file) == 1);
+    result = (fclose(file) == 0) && result;
+    if (!result || (rename(temporaryPath.c_str(), path.c_str()) != 0)) {
+        Log::warn("Cannot save program binary %s", path.c_str());
+        unlink(temporaryPath.c_str());
+    }
+}
+
+void ProgramCache::remove(uint64_t pKey) {
+    mBinaries.erase(pKey);
+    if (!mDirectory.empty()) unlink(getPath(pKey).c_str());
+}
+
+std::string ProgramCache::getPath(uint64_t pKey) {
+    char name[24];
+    snprintf(name, sizeof(name), "/%016llx.bin", (unsigned long long) pKey);
+    return mDirectory + name;
+}
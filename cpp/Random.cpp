@@ -0,0 +1,36 @@
+//
+// Created by cjf12 on 2019-11-10.
+//
+
+#include "include/Random.h"
+
+//Expands a 64 bits seed into well mixed state words (splitmix64).
+static uint64_t splitMix(uint64_t &pState) {
+    uint64_t z = (pState += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+Random::Random(uint64_t pSeed, uint32_t pStream) {
+    seed(pSeed, pStream);
+}
+
+void Random::seed(uint64_t pSeed, uint32_t pStream) {
+    uint64_t state = pSeed ^ (uint64_t(pStream) * 0xD1B54A32D192ED03ULL);
+    uint64_t first = splitMix(state);
+    uint64_t second = splitMix(state);
+    mState[0] = uint32_t(first);
+    mState[1] = uint32_t(first >> 32);
+    mState[2] = uint32_t(second);
+    mState[3] = uint32_t(second >> 32);
+    //An all zero state would only ever produce zeros.
+    if ((mState[0] | mState[1] | mState[2] | mState[3]) == 0) mState[0] = 1;
+}
+
+void Random::fill(float *pValues, int32_t pCount, float pMin, float pMax) {
+    float scale = (pMax - pMin) / 16777216.0f;
+    for (int i = 0; i < pCount; ++i) {
+        pValues[i] = pMin + float(next() >> 8) * scale;
+    }
+}
@@ -3,32 +3,166 @@
 //
 
 #include "include/Resource.h"
+#include "include/AssetArchive.h"
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
 
-Resource::Resource(android_app *pApplication, const char *pPath) :
-        mPath(std::string("/sdcard/") + pPath),
-        mInputStream() {
+//Where asset files live. Overridden by the host build.
+#ifndef DROIDBLASTER_ASSET_ROOT
+#define DROIDBLASTER_ASSET_ROOT "/sdcard/"
+#endif
+//Archive, under the asset root, taking precedence over loose files.
+#ifndef DROIDBLASTER_ASSET_ARCHIVE
+#define DROIDBLASTER_ASSET_ARCHIVE "droidblaster.pak"
+#endif
+
+//Stands for the mapping of an empty file, which mmap() refuses.
+static const uint8_t EMPTY_BUFFER[1] = {0};
+
+static AssetArchive *openArchive() {
+    AssetArchive *archive = new AssetArchive();
+    archive->open(DROIDBLASTER_ASSET_ROOT DROIDBLASTER_ASSET_ARCHIVE);
+    return archive;
+}
+
+//Opened once, by the first resource, and kept for the whole process
+//since resources of static objects may outlive any owner.
+static AssetArchive &getArchive() {
+    static AssetArchive *archive = openArchive();
+    return *archive;
+}
+
+//Assets are read from the file system, the application is not needed.
+Resource::Resource(android_app */*pApplication*/, const char *pPath) :
+        mName(pPath),
+        mPath(std::string(DROIDBLASTER_ASSET_ROOT) + pPath),
+        mInputStream(),
+        mEntry(NULL),
+        mBuffer(NULL), mLength(0), mOffset(0) {
+    AssetArchive &archive = getArchive();
+    if (archive.isOpen()) {
+        mEntry = archive.find(pPath);
+    }
+}
+
+Resource::~Resource() {
+    unmap();
 }
 
 status Resource::open() {
+    //Archived resources are always read through their mapping.
+    if (mEntry != NULL) return map();
     mInputStream.open(mPath.c_str(), std::ios::in | std::ios::binary);
     return mInputStream ? STATUS_OK : STATUS_KO;
 }
 
 void Resource::close() {
+    if (mEntry != NULL) {
+        unmap();
+        return;
+    }
     mInputStream.close();
 }
 
 status Resource::read(void *pBuffer, size_t pCount) {
+    //Mapped resources are consumed straight from the mapping.
+    if (mBuffer != NULL) {
+        if (pCount > size_t(mLength - mOffset)) return STATUS_KO;
+        memcpy(pBuffer, mBuffer + mOffset, pCount);
+        mOffset += pCount;
+        return STATUS_OK;
+    }
     mInputStream.read((char*)pBuffer, pCount);
     return (!mInputStream.fail())? STATUS_OK: STATUS_KO;
 }
 
+status Resource::map() {
+    //Already mapped: only rewinds reads.
+    mOffset = 0;
+    if (mBuffer != NULL) return STATUS_OK;
+    if (mEntry != NULL) return mapEntry();
+
+    int fd = ::open(mPath.c_str(), O_RDONLY);
+    if (fd < 0) return STATUS_KO;
+    struct stat filestatus;
+    void *buffer;
+    if (fstat(fd, &filestatus) < 0) {
+        ::close(fd);
+        return STATUS_KO;
+    }
+    //Empty files are valid resources with nothing to read.
+    if (filestatus.st_size == 0) {
+        ::close(fd);
+        mBuffer = EMPTY_BUFFER;
+        mLength = 0;
+        return STATUS_OK;
+    }
+    //Pages are read on first access, not here.
+    buffer = mmap(NULL, filestatus.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    //The mapping keeps the file alive on its own.
+    ::close(fd);
+    if (buffer == MAP_FAILED) return STATUS_KO;
+
+    mBuffer = (const uint8_t*) buffer;
+    mLength = filestatus.st_size;
+    return STATUS_OK;
+}
+
+status Resource::mapEntry() {
+    const uint8_t *data = getArchive().getData(*mEntry);
+    //Stored entries are a view on the archive mapping.
+    if (!(mEntry->flags & ASSET_ARCHIVE_DEFLATED)) {
+        mBuffer = data;
+        mLength = mEntry->length;
+        return STATUS_OK;
+    }
+
+    uLongf length = mEntry->length;
+    uint8_t *buffer = new uint8_t[length];
+    if ((uncompress(buffer, &length, data, mEntry->size) != Z_OK)
+        || (length != mEntry->length)) {
+        delete[] buffer;
+        return STATUS_KO;
+    }
+    mBuffer = buffer;
+    mLength = length;
+    return STATUS_OK;
+}
+
+void Resource::unmap() {
+    if (mBuffer != NULL) {
+        if (mEntry == NULL) {
+            if (mBuffer != EMPTY_BUFFER) munmap((void*) mBuffer, mLength);
+        } else if (mEntry->flags & ASSET_ARCHIVE_DEFLATED) {
+            delete[] mBuffer;
+        }
+        mBuffer = NULL;
+        mLength = 0;
+        mOffset = 0;
+    }
+}
+
 bool Resource::operator==(const Resource &pOther) {
     return mPath == pOther.mPath;
 }
 
+status Resource::getDescriptor(int32_t &pDescriptor, off_t &pStart, off_t &pLength) {
+    //Only stored entries can be read in place from the archive file.
+    if ((mEntry == NULL) || (mEntry->flags & ASSET_ARCHIVE_DEFLATED)) return STATUS_KO;
+    pDescriptor = getArchive().getDescriptor();
+    pStart = mEntry->offset;
+    pLength = mEntry->length;
+    return STATUS_OK;
+}
+
 off_t Resource::getLength() {
+    if (mBuffer != NULL) return mLength;
+    if (mEntry != NULL) return mEntry->length;
+
     struct stat filestatus;
     if (stat(mPath.c_str(), &filestatus) >= 0) {
         return filestatus.st_size;
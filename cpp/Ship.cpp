@@ -15,12 +15,13 @@ static const int32_t SHIP_DESTROY_FRAME_COUNT = 9;
 static const float SHIP_DESTROY_ANIM_SPEED = 12.0f;
 
 Ship::Ship(android_app *pApplication, GraphicsManager &pGraphicsManager,
-           SoundManager &pSoundManager) :
+           SoundManager &pSoundManager, PhysicsManager &pPhysicsManager) :
         mGraphicsManager(pGraphicsManager),
         mSoundManager(pSoundManager),
+        mPhysicsManager(pPhysicsManager),
         mCollisionSound(NULL),
         mGraphics(NULL),
-        mBody(NULL),
+        mBody(NULL), mBodyIndex(-1),
         mDestroyed(false),
         mLives(0) {
 
@@ -30,6 +31,7 @@ void Ship::registerShip(Sprite *pGraphics, Sound *pCollisionSound, b2Body *pBody
     mGraphics = pGraphics;
     mCollisionSound = pCollisionSound;
     mBody = pBody;
+    mBodyIndex = PhysicsManager::getBodyIndex(pBody);
 }
 
 void Ship::initialize() {
@@ -44,9 +46,24 @@ void Ship::initialize() {
     mBody->SetActive(true);
 }
 
+bool Ship::collided() {
+    //Scans the few contacts of this frame rather than polling the body.
+    //An overflowing queue still flags the bodies it dropped.
+    const ContactEventQueue &contacts = mPhysicsManager.getContactEvents();
+    if (contacts.isDropped(mBodyIndex)) return true;
+    for (int i = 0; i < contacts.size(); ++i) {
+        const ContactEvent &contact = contacts[i];
+        if ((contact.type == ContactEvent::BEGIN)
+            && ((contact.bodyA == mBodyIndex) || (contact.bodyB == mBodyIndex))) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void Ship::update() {
     if (mLives >= 0) {
-        if (((PhysicsCollision *) mBody->GetUserData())->collide) {
+        if (collided()) {
             mSoundManager.playSound(mCollisionSound);
             --mLives;
             if (mLives < 0) {
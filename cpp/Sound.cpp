@@ -24,23 +24,19 @@ const char *Sound::getPath() {
 }
 
 status Sound::load() {
-    Log::info("Loading sound %s", mResource->getPath());
-    status result;
-
     //Opens sound file.
     if (mResource == NULL) {
         Log::info("Allocating sound");
         mBuffer = new uint8_t[mLength];
     } else {
         Log::info("Loading sound %s", mResource->getPath());
-        if (mResource->open() != STATUS_OK) {
+        //Maps PCM data which is then enqueued as is. Pages are
+        //only read from storage when the sound is first played.
+        if (mResource->map() != STATUS_OK) {
             goto ERROR;
         }
-        //Reads sound file
+        mBuffer = (uint8_t*) mResource->getBuffer();
         mLength = mResource->getLength();
-        mBuffer = new uint8_t[mLength];
-        result = mResource->read(mBuffer, mLength);
-        mResource->close();
     }
     return STATUS_OK;
 
@@ -50,7 +46,11 @@ status Sound::load() {
 }
 
 status Sound::unload() {
-    delete[] mBuffer;
+    if (mResource == NULL) {
+        delete[] mBuffer;
+    } else {
+        mResource->unmap();
+    }
     mBuffer = NULL;
     mLength = 0;
     return STATUS_KO;
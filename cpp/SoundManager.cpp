@@ -100,11 +100,16 @@ status SoundManager::playBGM(Resource &pResource) {
     SLresult result;
     Log::info("Opening BGM %s", pResource.getPath());
 
-    //Set up BGM audio source.
+    //Set up BGM audio source. Archived music is streamed from the
+    //archive descriptor, loose files from their path.
     SLDataLocator_URI dataLocatorUIn;
+    SLDataLocator_AndroidFD dataLocatorFDIn;
     std::string path = pResource.getPath();
+    int32_t descriptor;
+    off_t start, length;
     dataLocatorUIn.locatorType = SL_DATALOCATOR_URI;
     dataLocatorUIn.URI = (SLchar*) path.c_str();
+    dataLocatorFDIn.locatorType = SL_DATALOCATOR_ANDROIDFD;
 
     SLDataFormat_MIME dataFormat;
     dataFormat.formatType = SL_DATAFORMAT_MIME;
@@ -114,6 +119,16 @@ status SoundManager::playBGM(Resource &pResource) {
     SLDataSource dataSource;
     dataSource.pLocator = &dataLocatorUIn;
     dataSource.pFormat = &dataFormat;
+    if (pResource.getDescriptor(descriptor, start, length) == STATUS_OK) {
+        dataLocatorFDIn.fd = descriptor;
+        dataLocatorFDIn.offset = start;
+        dataLocatorFDIn.length = length;
+        dataSource.pLocator = &dataLocatorFDIn;
+    } else if (pResource.isArchived()) {
+        //Deflated entries have no loose file to fall back on.
+        Log::error("BGM %s cannot be streamed from the archive", pResource.getPath());
+        return STATUS_KO;
+    }
 
     SLDataLocator_OutputMix dataLocatorOut;
     dataLocatorOut.locatorType = SL_DATALOCATOR_OUTPUTMIX;
@@ -7,28 +7,37 @@
 Sprite::Sprite(GraphicsManager &pGraphicsManager, Resource &pTextureResource, int32_t pHeight,
                int32_t pWidth) :
         location(),
-        mTextureResource(pTextureResource), mTexture(0),
+        mTextureResource(&pTextureResource), mTexture(0),
         mSheetWidth(0), mSheetHeight(0),
         mSpriteHeight(pHeight), mSpriteWidth(pWidth),
-        mFrameCount(0), mFrameXCount(0), mFrameYCount(0),
+        mFrameCount(0), mFrames(NULL),
         mAnimStartFrame(0), mAnimFrameCount(1),
-        mAnimSpeed(0), mAnimFrame(0), mAnimLoop(false) {
+        mAnimSpeed(0), mAnimFrame(0), mAnimLoop(false),
+        mScale(1.0f),
+        mBodyStates(NULL), mBodyIndex(-1),
+        mLayer(0) {
 
 }
 
 status Sprite::load(GraphicsManager &pGraphicsManager) {
-    TextureProperties *textureProperties = pGraphicsManager.loadTexture(mTextureResource);
+    TextureProperties *textureProperties = pGraphicsManager.loadTexture(*mTextureResource);
     if (textureProperties == NULL) return STATUS_KO;
     mTexture = textureProperties->texture;
     mSheetWidth = textureProperties->width;
     mSheetHeight = textureProperties->height;
 
-    mFrameXCount = mSheetWidth / mSpriteWidth;
-    mFrameYCount = mSheetHeight / mSpriteHeight;
-    mFrameCount = (mSheetHeight / mSpriteHeight) * (mSheetWidth / mSpriteWidth);
+    //Frame coordinates are shared by all sprites cut the same way.
+    mFrames = pGraphicsManager.loadFrameTable(*mTextureResource, mSpriteWidth, mSpriteHeight);
+    if (mFrames == NULL) return STATUS_KO;
+    mFrameCount = mFrames->frameCount;
     return STATUS_OK;
 }
 
+void Sprite::bindBody(const BodyStates *pBodyStates, int32_t pBodyIndex) {
+    mBodyStates = pBodyStates;
+    mBodyIndex = pBodyIndex;
+}
+
 void Sprite::setAnimation(int32_t pStartFrame, int32_t pFrameCount, float pSpeed, bool pLoop) {
     mAnimStartFrame = pStartFrame;
     mAnimFrame = 0.0f;
@@ -37,8 +46,18 @@ void Sprite::setAnimation(int32_t pStartFrame, int32_t pFrameCount, float pSpeed
     mAnimFrameCount = pFrameCount;
 }
 
-void Sprite::draw(Sprite::Vertex pVertices[4], float pTimeStep) {
-    int32_t currentFrame, currentFrameX, currentFrameY;
+void Sprite::initializeQuad(SpriteQuads &pQuads, int32_t pIndex) {
+    //Sprites are centered on their location.
+    pQuads.offsetX[pIndex] = -float(mSpriteWidth / 2);
+    pQuads.offsetY[pIndex] = -float(mSpriteHeight / 2);
+    pQuads.width[pIndex] = mSpriteWidth;
+    pQuads.height[pIndex] = mSpriteHeight;
+    pQuads.frameWidth[pIndex] = mFrames->frameWidth;
+    pQuads.frameHeight[pIndex] = mFrames->frameHeight;
+}
+
+void Sprite::draw(SpriteQuads &pQuads, int32_t pIndex, float pTimeStep) {
+    int32_t currentFrame;
     //Updates animation in a loop mode
     mAnimFrame += pTimeStep * mAnimSpeed;
     if (mAnimLoop) {
@@ -51,39 +70,20 @@ void Sprite::draw(Sprite::Vertex pVertices[4], float pTimeStep) {
             currentFrame = mAnimStartFrame + int32_t(mAnimFrame);
         }
     }
-    //Computes frame X and Y indexes from its id.
-    currentFrameX = currentFrame % mFrameXCount;
-    currentFrameY = mFrameYCount - 1 - (currentFrame / mFrameXCount);
-
-    //Draws selected frame.
-    GLfloat posX1 = location.x - float(mSpriteWidth / 2);
-    GLfloat posY1 = location.y - float(mSpriteHeight / 2);
-    GLfloat posX2 = posX1 + mSpriteWidth;
-    GLfloat posY2 = posY1 + mSpriteHeight;
-    GLfloat u1 = GLfloat(currentFrameX * mSpriteWidth) / GLfloat(mSheetWidth);
-    GLfloat u2 = GLfloat((currentFrameX + 1) * mSpriteWidth) / GLfloat(mSheetWidth);
-    GLfloat v1 = GLfloat(currentFrameY * mSpriteHeight) / GLfloat(mSheetHeight);
-    GLfloat v2 = GLfloat((currentFrameY + 1) * mSpriteHeight) / GLfloat(mSheetHeight);
+    //Animations past the end of the sheet stop on its last frame.
+    if (currentFrame >= mFrameCount) currentFrame = mFrameCount - 1;
 
-    pVertices[0].x = posX1;
-    pVertices[0].y = posY1;
-    pVertices[0].u = u1;
-    pVertices[0].v = v1;
-
-    pVertices[1].x = posX1;
-    pVertices[1].y = posY2;
-    pVertices[1].u = u1;
-    pVertices[1].v = v2;
-
-    pVertices[2].x = posX2;
-    pVertices[2].y = posY1;
-    pVertices[2].u = u2;
-    pVertices[2].v = v1;
+    //Follows the physics body, if any. location stays readable by others.
+    if (mBodyStates != NULL) {
+        location.x = mBodyStates->x[mBodyIndex];
+        location.y = mBodyStates->y[mBodyIndex];
+    }
 
-    pVertices[3].x = posX2;
-    pVertices[3].y = posY2;
-    pVertices[3].u = u2;
-    pVertices[3].v = v2;
+    //Selects the frame. Vertices are generated by the batch.
+    pQuads.x[pIndex] = location.x;
+    pQuads.y[pIndex] = location.y;
+    pQuads.u[pIndex] = mFrames->u[currentFrame];
+    pQuads.v[pIndex] = mFrames->v[currentFrame];
+    pQuads.frame[pIndex] = GLfloat(currentFrame);
+    pQuads.scale[pIndex] = mScale;
 }
-
-
@@ -5,46 +5,177 @@
 #include "include/SpriteBatch.h"
 #include "include/Log.h"
 #include <GLES2/gl2.h>
+#include <algorithm>
+#include <stddef.h>
 
-SpriteBatch::SpriteBatch(TimeManager &pTimeManager, GraphicsManager &pGraphicsManager)
+//Vertex buffers cycled through, so that the frame being written does not
+//wait for the GPU to release the one drawn the previous frames.
+static const int32_t VERTEX_BUFFER_RING_SIZE = 3;
+
+//Sprites addressable with 16-bit indexes, 4 vertices each. Larger batches
+//are drawn in windows of this size.
+static const int32_t MAX_SPRITES_PER_DRAW = 65536 / 4;
+
+//Pool size when sprites are registered without any reservation.
+static const int32_t DEFAULT_SPRITE_POOL_SIZE = 256;
+
+//Sprites are drawn by layer first, then grouped by texture so that each
+//group costs a single bind, then by frame table so that instanced groups
+//cost a single draw call. Sorting is stable: sprites with equal keys keep
+//their registration order.
+class SpriteOrder {
+public:
+    uint64_t key(const Sprite *pSprite) const {
+        uint16_t frames = (pSprite->mFrames != NULL) ? uint16_t(pSprite->mFrames->id) : 0;
+        //Layers are biased so that negative (background) ones sort first.
+        return (uint64_t(uint16_t(int32_t(pSprite->mLayer) + 0x8000)) << 48)
+               | (uint64_t(pSprite->mTexture) << 16)
+               | uint64_t(frames);
+    }
+
+    bool operator()(const Sprite *pSprite1, const Sprite *pSprite2) const {
+        return key(pSprite1) < key(pSprite2);
+    }
+};
+
+SpriteBatch::SpriteBatch(TimeManager &pTimeManager, GraphicsManager &pGraphicsManager,
+                         bool pInstanced)
         : mTimeManager(pTimeManager),
           mGraphicsManager(pGraphicsManager),
-          mSprites(),
-          mVertices(),
+          mInstanced(pInstanced), mMode(MODE_VERTICES), mLoaded(false),
+          mSprites(), mFreeSprites(), mDrawIndexes(), mDrawOrder(),
+          mQuads(), mVisibleQuads(), mVisibleIndexes(), mVisibleOrder(), mVisibleCount(0),
+          mVertices(), mInstances(),
           mIndexes(),
+          mIndexBuffer(0), mQuadBuffer(0), mVertexBuffers(), mCurrentVertexBuffer(0),
           mShaderProgram(0),
-          aPosition(-1), aTexture(-1), uProjection(-1), uTexture(-1) {
+          mDrawCallCount(0), mTextureBindCount(0), mCulledCount(0),
+          aPosition(-1), aTexture(-1), aCorner(-1), aInstance(-1),
+          uProjection(-1), uTexture(-1), uAlpha(-1), uSeparateAlpha(-1),
+          uQuad(-1), uFrame(-1), uOrigin(-1),
+          mSeparateAlpha(false) {
     mGraphicsManager.registerComponent(this);
 }
 
 SpriteBatch::~SpriteBatch() {
-    std::vector<Sprite*>::iterator spriteIt;
-    for (spriteIt = mSprites.begin(); spriteIt < mSprites.end();
-    ++spriteIt){
-        delete(*spriteIt);
+}
+
+void SpriteBatch::reserveSprites(int32_t pCount) {
+    //Sprites are handed out by address: the pool must never move.
+    if (!mSprites.empty()) {
+        Log::error("Sprites must be reserved before being registered");
+        return;
     }
+    mSprites.reserve(pCount);
+    mFreeSprites.reserve(pCount);
+    mDrawIndexes.reserve(pCount);
+    mDrawOrder.reserve(pCount);
+    mQuads.reserve(pCount);
 }
 
 Sprite *SpriteBatch::registerSprite(Resource &pTextureResource,
-                                    int32_t pHeight, int32_t pWidth) {
-    int32_t spriteCount = mSprites.size();
-    int32_t index = spriteCount * 4;
-    //Precomputes the index buffer. Each sprite is formed by
-    //2 trianglar vertices, each with 3 indexes, so there are
-    // 6 indexes
-    mIndexes.push_back(index+0);
-    mIndexes.push_back(index+1);
-    mIndexes.push_back(index+2);
-    mIndexes.push_back(index+2);
-    mIndexes.push_back(index+1);
-    mIndexes.push_back(index+3);
-    for (int i = 0; i < 4; ++i) {
-        mVertices.push_back(Sprite::Vertex());
-    }
-
-    //Appends a new sprite to the sprite array.
-    mSprites.push_back(new Sprite(mGraphicsManager, pTextureResource, pHeight, pWidth));
-    return mSprites.back();
+                                    int32_t pHeight, int32_t pWidth, int32_t pLayer) {
+    //Reuses a released slot, or takes the next reserved one.
+    int32_t slot;
+    Sprite sprite(mGraphicsManager, pTextureResource, pHeight, pWidth);
+    sprite.mLayer = pLayer;
+    if (mSprites.capacity() == 0) reserveSprites(DEFAULT_SPRITE_POOL_SIZE);
+    if (!mFreeSprites.empty()) {
+        slot = mFreeSprites.back();
+        mFreeSprites.pop_back();
+        mSprites[slot] = sprite;
+    } else if (mSprites.size() < mSprites.capacity()) {
+        slot = mSprites.size();
+        mSprites.push_back(sprite);
+        mDrawIndexes.push_back(-1);
+    } else {
+        Log::error("Sprite pool exhausted (%d sprites)", int32_t(mSprites.size()));
+        return NULL;
+    }
+
+    if (!mLoaded) {
+        //Sorted all at once by load().
+        mDrawIndexes[slot] = mDrawOrder.size();
+        mDrawOrder.push_back(&mSprites[slot]);
+    } else {
+        if (mSprites[slot].load(mGraphicsManager) != STATUS_OK) {
+            mFreeSprites.push_back(slot);
+            return NULL;
+        }
+        insertDrawOrder(slot);
+    }
+    return &mSprites[slot];
+}
+
+void SpriteBatch::unregisterSprite(Sprite *pSprite) {
+    //Foreign or already released sprites would corrupt the free list.
+    int32_t slot = -1;
+    if ((pSprite != NULL) && !mSprites.empty() && (pSprite >= &mSprites[0])
+        && (pSprite < &mSprites[0] + mSprites.size())) {
+        slot = pSprite - &mSprites[0];
+    }
+    if ((slot < 0) || (mDrawIndexes[slot] < 0)) {
+        Log::error("Cannot unregister sprite %p", pSprite);
+        return;
+    }
+    if (!mLoaded) {
+        moveDrawOrder(mDrawOrder.size() - 1, mDrawIndexes[slot]);
+        mDrawOrder.pop_back();
+    } else {
+        removeDrawOrder(slot);
+    }
+    mDrawIndexes[slot] = -1;
+    mFreeSprites.push_back(slot);
+}
+
+//Draw order entries with the same key form a group, in key order. Entries
+//are only moved one per group, from the end of a group to the start of
+//the next one (or the other way around), so that insertions and removals
+//cost a few moves whatever the sprite count. Order within a group is not
+//kept.
+void SpriteBatch::moveDrawOrder(int32_t pFrom, int32_t pTo) {
+    if (pFrom == pTo) return;
+    Sprite *sprite = mDrawOrder[pFrom];
+    mDrawOrder[pTo] = sprite;
+    mDrawIndexes[sprite - &mSprites[0]] = pTo;
+    if (mLoaded) mQuads.copy(pFrom, pTo);
+}
+
+void SpriteBatch::insertDrawOrder(int32_t pSlot) {
+    SpriteOrder order;
+    Sprite *sprite = &mSprites[pSlot];
+    int32_t hole = mDrawOrder.size();
+    mDrawOrder.push_back(sprite);
+    mQuads.resize(hole + 1);
+    //Shifts the first entry of each following group to its end.
+    while ((hole > 0) && order(sprite, mDrawOrder[hole - 1])) {
+        int32_t groupStart = std::lower_bound(mDrawOrder.begin(), mDrawOrder.begin() + hole,
+                                              mDrawOrder[hole - 1], order) - mDrawOrder.begin();
+        moveDrawOrder(groupStart, hole);
+        hole = groupStart;
+    }
+    mDrawOrder[hole] = sprite;
+    mDrawIndexes[pSlot] = hole;
+    sprite->initializeQuad(mQuads, hole);
+}
+
+void SpriteBatch::removeDrawOrder(int32_t pSlot) {
+    SpriteOrder order;
+    int32_t count = mDrawOrder.size();
+    int32_t hole = mDrawIndexes[pSlot];
+    //Fills the hole with the last entry of its group, then the hole left
+    //there with the last entry of the next group, and so on.
+    Sprite *group = mDrawOrder[hole];
+    while (true) {
+        int32_t groupEnd = std::upper_bound(mDrawOrder.begin() + hole + 1, mDrawOrder.end(),
+                                            group, order) - mDrawOrder.begin();
+        moveDrawOrder(groupEnd - 1, hole);
+        hole = groupEnd - 1;
+        if (hole >= count - 1) break;
+        group = mDrawOrder[hole + 1];
+    }
+    mDrawOrder.pop_back();
+    mQuads.resize(count - 1);
 }
 
 static const char *VERTEX_SHADER =
@@ -57,32 +188,127 @@ static const char *VERTEX_SHADER =
         "   gl_Position = uProjection * aPosition;\n" //gl_Position is a global output variable in shader program. The projection matrix transform a coordinate from model view -> world view -> camera view. The MVP matrix http://www.opengl-tutorial.org/beginners-tutorials/tutorial-3-matrices/ .
         "}";
 
+//Expands a shared quad for each sprite instance: the frame id is turned
+//into texture coordinates with the frame table layout of the draw call.
+static const char *INSTANCE_VERTEX_SHADER =
+        "attribute vec2 aCorner;\n"   //Corner of the shared quad, from (0, 0) to (1, 1).
+        "attribute vec4 aInstance;\n" //Sprite center, frame id and scale.
+        "varying vec2 vTexture;\n"
+        "uniform mat4 uProjection;\n"
+        "uniform vec4 uQuad;\n"       //Bottom-left corner offset from the center and size, in pixels.
+        "uniform vec4 uFrame;\n"      //Frame size in texture coordinates, frames per row and rows.
+        "uniform vec2 uOrigin;\n"     //Bottom-left corner of the sheet in its texture.
+        "void main(){\n"
+        "   float row = floor((aInstance.z + 0.5) / uFrame.z);\n" //Biased against division rounding.
+        "   vec2 frame = vec2(aInstance.z - row * uFrame.z, uFrame.w - 1.0 - row);\n"
+        "   vTexture = uOrigin + (frame + aCorner) * uFrame.xy;\n"
+        "   vec2 position = aInstance.xy + (uQuad.xy + aCorner * uQuad.zw) * aInstance.w;\n"
+        "   gl_Position = uProjection * vec4(position, 0.0, 1.0);\n"
+        "}";
+
 static const char *FRAGMENT_SHADER =
         "precision mediump float;\n"  // define the precision specification of the entire program
         "varying vec2 vTexture;\n" // The qualifier varying are used to define variables that can pass values from the vertex shader to the fragment shader.
         "uniform sampler2D u_texture;\n"
+        "uniform sampler2D u_alpha;\n"      //Alpha plane of ETC1 textures, which have no alpha.
+        "uniform bool u_separateAlpha;\n"
         "void main() {\n"
         "   gl_FragColor = texture2D(u_texture, vTexture);\n" //Sample the color of u_texture at location vTexture. Before calling the program, caller code needs to load the texture and bind the texture into texture2D. gl_BindTexture.
+        "   if (u_separateAlpha) gl_FragColor.a = texture2D(u_alpha, vTexture).r;\n"
         "}";
 
 status SpriteBatch::load() {
 
     GLint result;
-    int32_t spriteCount;
-    mShaderProgram = mGraphicsManager.loadShader(VERTEX_SHADER, FRAGMENT_SHADER); //convert the shader into executable.
-    if (mShaderProgram == 0) return STATUS_KO;
-    aPosition = glGetAttribLocation(mShaderProgram, "aPosition"); //Get a handle to a variable in the shader program. The handle can be set by glBindAttribLocation. But only go into effect when the program is linked.
-    aTexture = glGetAttribLocation(mShaderProgram, "aTexture");
+    int32_t spriteCount = mDrawOrder.size(), streamSize;
+    //Buffers are sized for the whole pool, so that sprites can come and go.
+    int32_t capacity = mSprites.capacity();
+    //Instancing support is only known once the context exists. Without
+    //it, streamed vertices still draw a window in a single call.
+    mMode = (mInstanced && mGraphicsManager.hasInstancing()) ? MODE_INSTANCES : MODE_VERTICES;
+
+    if (mMode == MODE_VERTICES) {
+        mShaderProgram = mGraphicsManager.loadShader(VERTEX_SHADER, FRAGMENT_SHADER); //convert the shader into executable.
+        if (mShaderProgram == 0) return STATUS_KO;
+        aPosition = glGetAttribLocation(mShaderProgram, "aPosition"); //Get a handle to a variable in the shader program. The handle can be set by glBindAttribLocation. But only go into effect when the program is linked.
+        aTexture = glGetAttribLocation(mShaderProgram, "aTexture");
+    } else {
+        mShaderProgram = mGraphicsManager.loadShader(INSTANCE_VERTEX_SHADER, FRAGMENT_SHADER);
+        if (mShaderProgram == 0) return STATUS_KO;
+        aCorner = glGetAttribLocation(mShaderProgram, "aCorner");
+        aInstance = glGetAttribLocation(mShaderProgram, "aInstance");
+        uQuad = glGetUniformLocation(mShaderProgram, "uQuad");
+        uFrame = glGetUniformLocation(mShaderProgram, "uFrame");
+        uOrigin = glGetUniformLocation(mShaderProgram, "uOrigin");
+    }
     uProjection = glGetUniformLocation(mShaderProgram, "uProjection"); //Get a handle to a uniform variable in the shader program.
                                                                        //A uniform variable is constant throughout the program,
                                                                        //but it is changeable by external program via glUniform()
                                                                        //function to set the value.
     uTexture = glGetUniformLocation(mShaderProgram, "u_texture");
+    uAlpha = glGetUniformLocation(mShaderProgram, "u_alpha");
+    uSeparateAlpha = glGetUniformLocation(mShaderProgram, "u_separateAlpha");
 
     //Loads sprites.
-    std::vector<Sprite*>::iterator spriteIt;
-    for (spriteIt = mSprites.begin(); spriteIt < mSprites.end();++spriteIt) {
-        if ((*spriteIt)->load(mGraphicsManager)!=STATUS_OK) goto ERROR;
+    mLoaded = false;
+    for (int i = 0; i < spriteCount; ++i) {
+        if (mDrawOrder[i]->load(mGraphicsManager)!=STATUS_OK) goto ERROR;
+    }
+
+    //Textures are only known once loaded: sorts the draw order now. Later
+    //registrations are inserted in place.
+    std::stable_sort(mDrawOrder.begin(), mDrawOrder.end(), SpriteOrder());
+    mQuads.resize(spriteCount);
+    for (int i = 0; i < spriteCount; ++i) {
+        mDrawIndexes[mDrawOrder[i] - &mSprites[0]] = i;
+        mDrawOrder[i]->initializeQuad(mQuads, i);
+    }
+    mVisibleQuads.resize(capacity);
+    mVisibleIndexes.resize(capacity);
+    mVisibleOrder.resize(capacity);
+    mVisibleCount = 0;
+    mLoaded = true;
+
+    //Indexes never change once sprites are registered: uploaded once.
+    //Vertices, or instances, are streamed each frame into a ring of buffers.
+    mIndexes.clear();
+    mVertices.clear();
+    mInstances.clear();
+    mVertexBuffers.clear();
+    if (capacity == 0) return STATUS_OK;
+    if (mMode == MODE_VERTICES) {
+        //Each sprite is formed by 2 trianglar vertices, each with 3
+        //indexes, so there are 6 indexes. Indexes are relative to the
+        //window being drawn, so they only cover one window.
+        for (int i = 0; i < std::min(capacity, MAX_SPRITES_PER_DRAW); ++i) {
+            GLushort index = GLushort(i * 4);
+            mIndexes.push_back(index+0);
+            mIndexes.push_back(index+1);
+            mIndexes.push_back(index+2);
+            mIndexes.push_back(index+2);
+            mIndexes.push_back(index+1);
+            mIndexes.push_back(index+3);
+        }
+        mVertices.resize(capacity * 4);
+    } else {
+        //A single quad, shared by all sprites.
+        const GLfloat corners[] = { 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f, 1.0f };
+        const GLushort indexes[] = { 0, 1, 2, 2, 1, 3 };
+        mIndexes.assign(indexes, indexes + 6);
+        mQuadBuffer = mGraphicsManager.loadVertexBuffer(corners, sizeof(corners));
+        if (mQuadBuffer == 0) goto ERROR;
+        mInstances.resize(capacity);
+    }
+    mIndexBuffer = mGraphicsManager.loadIndexBuffer(&mIndexes[0],
+                                                    mIndexes.size() * sizeof(GLushort));
+    if (mIndexBuffer == 0) goto ERROR;
+    streamSize = (mMode == MODE_VERTICES)
+                 ? mVertices.size() * sizeof(Sprite::Vertex)
+                 : mInstances.size() * sizeof(Sprite::Instance);
+    for (int i = 0; i < VERTEX_BUFFER_RING_SIZE; ++i) {
+        GLuint vertexBuffer = mGraphicsManager.loadStreamBuffer(streamSize);
+        if (vertexBuffer == 0) goto ERROR;
+        mVertexBuffers.push_back(vertexBuffer);
     }
 
     return STATUS_OK;
@@ -93,35 +319,18 @@ status SpriteBatch::load() {
 }
 
 void SpriteBatch::draw() {
+    mDrawCallCount = 0;
+    mTextureBindCount = 0;
+    mCulledCount = 0;
+    if (mDrawOrder.empty()) return;
     glUseProgram(mShaderProgram); //set a program to be in use. Install a program as part of the current rendering state
                                     //After a program is in-use, the shader objects are free to change, but not the linking part.
                                     //If a link is successful, the linked object will be installed.
     glUniformMatrix4fv(uProjection, 1, GL_FALSE, mGraphicsManager.getProjectionMatrix()); //load the uniform variable with a 4x4 matrix
     glUniform1i(uTexture, 0); //load the uniform variable with integer value
-
-    glEnableVertexAttribArray(aPosition); //Enable attribute array when drawing a vertex (official
-                                            // explanation  If enabled, the values in the generic
-                                            // vertex attribute array will be accessed and used for
-                                            // rendering when calls are made to vertex array commands
-                                            // such as glDrawArrays, glDrawElements, glDrawRangeElements,
-                                            // glMultiDrawElements, or glMultiDrawArrays.
-    glVertexAttribPointer(aPosition,
-                          2,
-                          GL_FLOAT,
-                          GL_FALSE,
-                          sizeof(Sprite::Vertex),
-                          &(mVertices[0].x));  //set the vertex attribute pointer. Basically, this method
-                                                // define loading value of type (GL_FLOAT) from an array
-                                                // pointed by &(mVertices[0].x into aPosition attribute
-                                                // in the shader program. The next value is size(Spite::Vertex)
-                                                // apart from the first one.
-    glEnableVertexAttribArray(aTexture);
-    glVertexAttribPointer(aTexture,
-                          2,
-                          GL_FLOAT,
-                          GL_FALSE,
-                          sizeof(Sprite::Vertex),
-                          &(mVertices[0].u));
+    glUniform1i(uAlpha, 1);
+    glUniform1i(uSeparateAlpha, 0);
+    mSeparateAlpha = false;
 
     glEnable(GL_BLEND);//In RGBA mode, pixels can be drawn using a function that blends the incoming
                         // (source) RGBA values with the RGBA values that are already in the frame
@@ -144,51 +353,206 @@ void SpriteBatch::draw() {
                                                        // of that buffer for destination color.
                                                        // (See glDrawBuffer.)
 
-    const int32_t vertexPerSprite = 4;
-    const int32_t indexPerSprite = 6;
     float timeStep = mTimeManager.elapsed();
-    int32_t spriteCount = mSprites.size();
-    int32_t currentSprite = 0, firstSprite = 0;
-    while (bool canDraw = (currentSprite < spriteCount)) {
+    int32_t spriteCount = mDrawOrder.size();
+
+    //Updates sprites, in draw order.
+    for (int i = 0; i < spriteCount; ++i) {
+        mDrawOrder[i]->draw(mQuads, i, timeStep);
+    }
+
+    //Leaves out sprites outside of the render target (e.g. asteroids
+    //waiting above the screen) before generating anything for them.
+    mVisibleCount = mQuads.compactVisible(0.0f, 0.0f,
+                                          GLfloat(mGraphicsManager.getRenderWidth()),
+                                          GLfloat(mGraphicsManager.getRenderHeight()),
+                                          mVisibleQuads, mVisibleIndexes);
+    for (int i = 0; i < mVisibleCount; ++i) {
+        mVisibleOrder[i] = mDrawOrder[mVisibleIndexes[i]];
+    }
+    mCulledCount = spriteCount - mVisibleCount;
+
+    if (mVisibleCount > 0) {
+        if (mMode == MODE_VERTICES) {
+            drawVertices();
+        } else {
+            drawInstances();
+        }
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    glUseProgram(0);
+    glDisable(GL_BLEND);
+}
+
+void SpriteBatch::drawVertices() {
+    const int32_t indexPerSprite = 6;
+    int32_t spriteCount = mVisibleCount;
+
+    //Generates vertices for the visible sprites.
+    mVisibleQuads.generateVertices(&mVertices[0].x, spriteCount);
+
+    //Uploads vertices once per frame. Respecifying the whole store lets
+    //the driver orphan the previous one instead of synchronizing.
+    mCurrentVertexBuffer = (mCurrentVertexBuffer + 1) % mVertexBuffers.size();
+    glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffers[mCurrentVertexBuffer]);
+    glBufferData(GL_ARRAY_BUFFER, spriteCount * 4 * sizeof(Sprite::Vertex), &mVertices[0],
+                 GL_STREAM_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+
+    glEnableVertexAttribArray(aPosition); //Enable attribute array when drawing a vertex (official
+                                            // explanation  If enabled, the values in the generic
+                                            // vertex attribute array will be accessed and used for
+                                            // rendering when calls are made to vertex array commands
+                                            // such as glDrawArrays, glDrawElements, glDrawRangeElements,
+                                            // glMultiDrawElements, or glMultiDrawArrays.
+    glVertexAttribPointer(aPosition,
+                          2,
+                          GL_FLOAT,
+                          GL_FALSE,
+                          sizeof(Sprite::Vertex),
+                          (GLvoid *) offsetof(Sprite::Vertex, x));  //set the vertex attribute pointer. With a
+                                                // buffer bound, the last parameter is an offset
+                                                // in the bound GL_ARRAY_BUFFER: aPosition is read
+                                                // from the x member of each vertex, the next value
+                                                // being size(Spite::Vertex) apart from the first one.
+    glEnableVertexAttribArray(aTexture);
+    glVertexAttribPointer(aTexture,
+                          2,
+                          GL_FLOAT,
+                          GL_FALSE,
+                          sizeof(Sprite::Vertex),
+                          (GLvoid *) offsetof(Sprite::Vertex, u));
+
+    int32_t currentSprite = 0, firstSprite = 0, windowSprite = 0;
+    while (currentSprite < spriteCount) {
         //Switches texture.
-        Sprite *sprite = mSprites[currentSprite];
-        GLuint currentTexture = sprite->mTexture;
+        GLuint currentTexture = mVisibleOrder[currentSprite]->mTexture;
         glActiveTexture(GL_TEXTURE0);       //glActiveTexture selects which texture unit subsequent
                                             // texture state calls will affect. The number of texture
                                             // units an implementation supports is implementation
                                             // dependent, but must be at least 80
-        glBindTexture(GL_TEXTURE_2D, sprite->mTexture);  // Create or use a named texture generated by
-                                                         // glGenTextures
+        glBindTexture(GL_TEXTURE_2D, currentTexture);  // Create or use a named texture generated by
+                                                       // glGenTextures
+        bindAlphaTexture(currentTexture);
+        ++mTextureBindCount;
 
-        //generate sprite vertices for current textures.
+        //Extends the draw call while the texture stays the same.
         do {
-            sprite = mSprites[currentSprite];
-            if (sprite->mTexture == currentTexture) {
-                Sprite::Vertex *vertices = (&mVertices[currentSprite * 4]);
-                sprite->draw(vertices, timeStep);
-            } else {
-                break;
+            ++currentSprite;
+        } while ((currentSprite < spriteCount)
+                 && (mVisibleOrder[currentSprite]->mTexture == currentTexture));
+
+        //Splits the draw call where it crosses a window.
+        while (firstSprite < currentSprite) {
+            if (firstSprite - windowSprite >= MAX_SPRITES_PER_DRAW) {
+                //Moves the attribute arrays to the start of the next window.
+                windowSprite += MAX_SPRITES_PER_DRAW;
+                GLintptr windowOffset = windowSprite * 4 * sizeof(Sprite::Vertex);
+                glVertexAttribPointer(aPosition, 2, GL_FLOAT, GL_FALSE, sizeof(Sprite::Vertex),
+                                      (GLvoid *) (windowOffset + offsetof(Sprite::Vertex, x)));
+                glVertexAttribPointer(aTexture, 2, GL_FLOAT, GL_FALSE, sizeof(Sprite::Vertex),
+                                      (GLvoid *) (windowOffset + offsetof(Sprite::Vertex, u)));
             }
-        } while (canDraw = (++currentSprite < spriteCount));
-        glDrawElements(GL_TRIANGLES,
-                //Number of indexes
-                       (currentSprite - firstSprite) * indexPerSprite,
-                       GL_UNSIGNED_SHORT,
-                       &mIndexes[firstSprite * indexPerSprite]);//When glDrawElements is called, it
+            int32_t lastSprite = std::min(currentSprite, windowSprite + MAX_SPRITES_PER_DRAW);
+            glDrawElements(GL_TRIANGLES,
+                    //Number of indexes
+                           (lastSprite - firstSprite) * indexPerSprite,
+                           GL_UNSIGNED_SHORT,
+                           (GLvoid *) ((firstSprite - windowSprite) * indexPerSprite
+                                       * sizeof(GLushort)));//When glDrawElements is called, it
                                                                 // uses count sequential elements
                                                                 // from an enabled array, starting
                                                                 // at indices to construct a sequence
-                                                                // of geometric primitives. mode specifies
-                                                                // what kind of primitives are constructed
-                                                                // and how the array elements construct
-                                                                // these primitives. If more than one
-                                                                // array is enabled, each is used.
-        firstSprite = currentSprite;
+                                                                // of geometric primitives. With an
+                                                                // element buffer bound, indices is
+                                                                // a byte offset into that buffer.
+            ++mDrawCallCount;
+            firstSprite = lastSprite;
+        }
     }
 
-    glUseProgram(0);
     glDisableVertexAttribArray(aPosition);
     glDisableVertexAttribArray(aTexture);
-    glDisable(GL_BLEND);
 }
 
+void SpriteBatch::bindAlphaTexture(GLuint pTexture) {
+    //Most textures have their own alpha: the second unit is only
+    //touched for those which do not.
+    GLuint alphaTexture = mGraphicsManager.getAlphaTexture(pTexture);
+    if (alphaTexture != 0) {
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, alphaTexture);
+        glActiveTexture(GL_TEXTURE0);
+    }
+    if ((alphaTexture != 0) != mSeparateAlpha) {
+        mSeparateAlpha = (alphaTexture != 0);
+        glUniform1i(uSeparateAlpha, mSeparateAlpha);
+    }
+}
+
+void SpriteBatch::drawInstances() {
+    int32_t spriteCount = mVisibleCount;
+
+    //Packs one record per sprite: a quarter of the vertex data.
+    mVisibleQuads.generateInstances(&mInstances[0].x, spriteCount);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, mQuadBuffer);
+    glEnableVertexAttribArray(aCorner);
+    glVertexAttribPointer(aCorner, 2, GL_FLOAT, GL_FALSE, 0, (GLvoid *) 0);
+    mCurrentVertexBuffer = (mCurrentVertexBuffer + 1) % mVertexBuffers.size();
+    glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffers[mCurrentVertexBuffer]);
+    glBufferData(GL_ARRAY_BUFFER, spriteCount * sizeof(Sprite::Instance),
+                 &mInstances[0], GL_STREAM_DRAW);
+    //aInstance advances once per instance instead of once per vertex.
+    glEnableVertexAttribArray(aInstance);
+    mGraphicsManager.vertexAttribDivisor(aInstance, 1);
+
+    GLuint currentTexture = 0;
+    int32_t currentSprite = 0, firstSprite = 0;
+    glActiveTexture(GL_TEXTURE0);
+    while (currentSprite < spriteCount) {
+        //Switches texture, when sheets are not in the same atlas.
+        if ((currentSprite == 0) || (mVisibleOrder[currentSprite]->mTexture != currentTexture)) {
+            currentTexture = mVisibleOrder[currentSprite]->mTexture;
+            glBindTexture(GL_TEXTURE_2D, currentTexture);
+            bindAlphaTexture(currentTexture);
+            ++mTextureBindCount;
+        }
+
+        //Frame layout and quad size are shared by all sprites cut the
+        //same way from a sheet: they are set once per draw call.
+        const FrameTable *frames = mVisibleOrder[currentSprite]->mFrames;
+        GLfloat quad[4] = {
+                mVisibleQuads.offsetX[currentSprite], mVisibleQuads.offsetY[currentSprite],
+                mVisibleQuads.width[currentSprite], mVisibleQuads.height[currentSprite]
+        };
+        GLfloat frame[4] = {
+                frames->frameWidth, frames->frameHeight,
+                GLfloat(frames->frameXCount), GLfloat(frames->frameYCount)
+        };
+        GLfloat origin[2] = { frames->originU, frames->originV };
+        glUniform4fv(uQuad, 1, quad);
+        glUniform4fv(uFrame, 1, frame);
+        glUniform2fv(uOrigin, 1, origin);
+
+        //Extends the draw call while the frame table stays the same.
+        do {
+            ++currentSprite;
+        } while ((currentSprite < spriteCount)
+                 && (mVisibleOrder[currentSprite]->mFrames == frames));
+        glVertexAttribPointer(aInstance, 4, GL_FLOAT, GL_FALSE, sizeof(Sprite::Instance),
+                              (GLvoid *) (firstSprite * sizeof(Sprite::Instance)));
+        mGraphicsManager.drawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT,
+                                               (GLvoid *) 0, currentSprite - firstSprite);
+        ++mDrawCallCount;
+        firstSprite = currentSprite;
+    }
+
+    //The divisor is attribute state: other components would inherit it.
+    mGraphicsManager.vertexAttribDivisor(aInstance, 0);
+    glDisableVertexAttribArray(aInstance);
+    glDisableVertexAttribArray(aCorner);
+}
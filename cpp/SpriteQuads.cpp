@@ -0,0 +1,184 @@
+//
+// Created by cjf12 on 2019-11-14.
+//
+
+#include "include/SpriteQuads.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define SPRITEQUADS_NEON
+#elif defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define SPRITEQUADS_SSE
+#endif
+
+void SpriteQuads::reserve(int32_t pCount) {
+    x.reserve(pCount);
+    y.reserve(pCount);
+    u.reserve(pCount);
+    v.reserve(pCount);
+    frame.reserve(pCount);
+    scale.reserve(pCount);
+    offsetX.reserve(pCount);
+    offsetY.reserve(pCount);
+    width.reserve(pCount);
+    height.reserve(pCount);
+    frameWidth.reserve(pCount);
+    frameHeight.reserve(pCount);
+}
+
+void SpriteQuads::resize(int32_t pCount) {
+    x.resize(pCount);
+    y.resize(pCount);
+    u.resize(pCount);
+    v.resize(pCount);
+    frame.resize(pCount);
+    scale.resize(pCount);
+    offsetX.resize(pCount);
+    offsetY.resize(pCount);
+    width.resize(pCount);
+    height.resize(pCount);
+    frameWidth.resize(pCount);
+    frameHeight.resize(pCount);
+}
+
+//Stores one vertex of 4 consecutive quads. Each quad owns 4 vertices of
+//4 floats, the vertex pCorner of quad q is at ((q * 4) + pCorner) * 4.
+#if defined(SPRITEQUADS_NEON)
+static inline void storeCorner(GLfloat *pVertices, int32_t pCorner, float32x4_t pX,
+                               float32x4_t pY, float32x4_t pU, float32x4_t pV) {
+    //4x4 transpose: one (x, y, u, v) vector per quad.
+    float32x4x2_t xy = vtrnq_f32(pX, pY);
+    float32x4x2_t uv = vtrnq_f32(pU, pV);
+    vst1q_f32(pVertices + (0 + pCorner) * 4,
+              vcombine_f32(vget_low_f32(xy.val[0]), vget_low_f32(uv.val[0])));
+    vst1q_f32(pVertices + (4 + pCorner) * 4,
+              vcombine_f32(vget_low_f32(xy.val[1]), vget_low_f32(uv.val[1])));
+    vst1q_f32(pVertices + (8 + pCorner) * 4,
+              vcombine_f32(vget_high_f32(xy.val[0]), vget_high_f32(uv.val[0])));
+    vst1q_f32(pVertices + (12 + pCorner) * 4,
+              vcombine_f32(vget_high_f32(xy.val[1]), vget_high_f32(uv.val[1])));
+}
+#elif defined(SPRITEQUADS_SSE)
+static inline void storeCorner(GLfloat *pVertices, int32_t pCorner, __m128 pX,
+                               __m128 pY, __m128 pU, __m128 pV) {
+    //4x4 transpose: one (x, y, u, v) vector per quad.
+    _MM_TRANSPOSE4_PS(pX, pY, pU, pV);
+    _mm_storeu_ps(pVertices + (0 + pCorner) * 4, pX);
+    _mm_storeu_ps(pVertices + (4 + pCorner) * 4, pY);
+    _mm_storeu_ps(pVertices + (8 + pCorner) * 4, pU);
+    _mm_storeu_ps(pVertices + (12 + pCorner) * 4, pV);
+}
+#endif
+
+void SpriteQuads::copy(int32_t pFrom, int32_t pTo) {
+    x[pTo] = x[pFrom];
+    y[pTo] = y[pFrom];
+    u[pTo] = u[pFrom];
+    v[pTo] = v[pFrom];
+    frame[pTo] = frame[pFrom];
+    scale[pTo] = scale[pFrom];
+    offsetX[pTo] = offsetX[pFrom];
+    offsetY[pTo] = offsetY[pFrom];
+    width[pTo] = width[pFrom];
+    height[pTo] = height[pFrom];
+    frameWidth[pTo] = frameWidth[pFrom];
+    frameHeight[pTo] = frameHeight[pFrom];
+}
+
+int32_t SpriteQuads::compactVisible(GLfloat pLeft, GLfloat pBottom,
+                                    GLfloat pRight, GLfloat pTop,
+                                    SpriteQuads &pVisible, std::vector<int32_t> &pIndexes) const {
+    int32_t count = size();
+    int32_t visibleCount = 0;
+    //Every quad is copied to the next free entry, which only advances when
+    //the quad is visible: no branch to mispredict on a scattered field.
+    for (int i = 0; i < count; ++i) {
+        GLfloat x1 = x[i] + offsetX[i] * scale[i], y1 = y[i] + offsetY[i] * scale[i];
+        GLfloat x2 = x1 + width[i] * scale[i], y2 = y1 + height[i] * scale[i];
+        int32_t visible = (x2 > pLeft) & (x1 < pRight) & (y2 > pBottom) & (y1 < pTop);
+
+        pVisible.x[visibleCount] = x[i];
+        pVisible.y[visibleCount] = y[i];
+        pVisible.u[visibleCount] = u[i];
+        pVisible.v[visibleCount] = v[i];
+        pVisible.frame[visibleCount] = frame[i];
+        pVisible.scale[visibleCount] = scale[i];
+        pVisible.offsetX[visibleCount] = offsetX[i];
+        pVisible.offsetY[visibleCount] = offsetY[i];
+        pVisible.width[visibleCount] = width[i];
+        pVisible.height[visibleCount] = height[i];
+        pVisible.frameWidth[visibleCount] = frameWidth[i];
+        pVisible.frameHeight[visibleCount] = frameHeight[i];
+        pIndexes[visibleCount] = i;
+        visibleCount += visible;
+    }
+    return visibleCount;
+}
+
+void SpriteQuads::generateVertices(GLfloat *pVertices, int32_t pCount) const {
+    int32_t count = pCount;
+    int32_t i = 0;
+
+#if defined(SPRITEQUADS_NEON)
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t s = vld1q_f32(&scale[i]);
+        float32x4_t x1 = vaddq_f32(vld1q_f32(&x[i]), vmulq_f32(vld1q_f32(&offsetX[i]), s));
+        float32x4_t y1 = vaddq_f32(vld1q_f32(&y[i]), vmulq_f32(vld1q_f32(&offsetY[i]), s));
+        float32x4_t x2 = vaddq_f32(x1, vmulq_f32(vld1q_f32(&width[i]), s));
+        float32x4_t y2 = vaddq_f32(y1, vmulq_f32(vld1q_f32(&height[i]), s));
+        float32x4_t u1 = vld1q_f32(&u[i]);
+        float32x4_t v1 = vld1q_f32(&v[i]);
+        float32x4_t u2 = vaddq_f32(u1, vld1q_f32(&frameWidth[i]));
+        float32x4_t v2 = vaddq_f32(v1, vld1q_f32(&frameHeight[i]));
+
+        GLfloat *vertices = pVertices + i * 16;
+        storeCorner(vertices, 0, x1, y1, u1, v1);
+        storeCorner(vertices, 1, x1, y2, u1, v2);
+        storeCorner(vertices, 2, x2, y1, u2, v1);
+        storeCorner(vertices, 3, x2, y2, u2, v2);
+    }
+#elif defined(SPRITEQUADS_SSE)
+    for (; i + 4 <= count; i += 4) {
+        __m128 s = _mm_loadu_ps(&scale[i]);
+        __m128 x1 = _mm_add_ps(_mm_loadu_ps(&x[i]), _mm_mul_ps(_mm_loadu_ps(&offsetX[i]), s));
+        __m128 y1 = _mm_add_ps(_mm_loadu_ps(&y[i]), _mm_mul_ps(_mm_loadu_ps(&offsetY[i]), s));
+        __m128 x2 = _mm_add_ps(x1, _mm_mul_ps(_mm_loadu_ps(&width[i]), s));
+        __m128 y2 = _mm_add_ps(y1, _mm_mul_ps(_mm_loadu_ps(&height[i]), s));
+        __m128 u1 = _mm_loadu_ps(&u[i]);
+        __m128 v1 = _mm_loadu_ps(&v[i]);
+        __m128 u2 = _mm_add_ps(u1, _mm_loadu_ps(&frameWidth[i]));
+        __m128 v2 = _mm_add_ps(v1, _mm_loadu_ps(&frameHeight[i]));
+
+        GLfloat *vertices = pVertices + i * 16;
+        storeCorner(vertices, 0, x1, y1, u1, v1);
+        storeCorner(vertices, 1, x1, y2, u1, v2);
+        storeCorner(vertices, 2, x2, y1, u2, v1);
+        storeCorner(vertices, 3, x2, y2, u2, v2);
+    }
+#endif
+
+    //Remaining quads, or all of them without SIMD.
+    for (; i < count; ++i) {
+        GLfloat x1 = x[i] + offsetX[i] * scale[i], y1 = y[i] + offsetY[i] * scale[i];
+        GLfloat x2 = x1 + width[i] * scale[i], y2 = y1 + height[i] * scale[i];
+        GLfloat u1 = u[i], v1 = v[i];
+        GLfloat u2 = u1 + frameWidth[i], v2 = v1 + frameHeight[i];
+
+        GLfloat *vertices = pVertices + i * 16;
+        vertices[0] = x1;  vertices[1] = y1;  vertices[2] = u1;  vertices[3] = v1;
+        vertices[4] = x1;  vertices[5] = y2;  vertices[6] = u1;  vertices[7] = v2;
+        vertices[8] = x2;  vertices[9] = y1;  vertices[10] = u2; vertices[11] = v1;
+        vertices[12] = x2; vertices[13] = y2; vertices[14] = u2; vertices[15] = v2;
+    }
+}
+
+void SpriteQuads::generateInstances(GLfloat *pInstances, int32_t pCount) const {
+    for (int i = 0; i < pCount; ++i) {
+        GLfloat *instance = pInstances + i * 4;
+        instance[0] = x[i];
+        instance[1] = y[i];
+        instance[2] = frame[i];
+        instance[3] = scale[i];
+    }
+}
@@ -5,16 +5,21 @@
 #include "include/StarField.h"
 #include "include/Log.h"
 
+//Random stream of the star field, see Random.
+static const uint32_t RANDOM_STREAM = 1;
+
 StarField::StarField(android_app *pApplication, TimeManager &pTimeManager,
                      GraphicsManager &pGraphicsManager, int32_t pStaCount,
-                     Resource &pTextureResource) :
+                     Resource &pTextureResource, uint64_t pSeed) :
         mTimeManager(pTimeManager),
         mGraphicsManager(pGraphicsManager),
+        mRandom(pSeed, RANDOM_STREAM),
         mStarCount(pStaCount),
         mTextureResource(pTextureResource),
         mVertexBuffer(0), mTexture(-1), mShaderProgram(0),
         aPosition(-1),
-        uProjection(-1), uHeight(-1), uTime(-1), uTexture(-1) {
+        uProjection(-1), uHeight(-1), uTime(-1), uTexture(-1), uRegion(-1),
+        mRegion() {
     mGraphicsManager.registerComponent(this);
 }
 
@@ -38,8 +43,9 @@ static const char *VERTEX_SHADER =
 static const char *FRAGMENT_SHADER =
         "precision mediump float;\n"
         "uniform sampler2D uTexture;\n"
+        "uniform vec4 uRegion;\n"
         "void main() {\n"
-        "       gl_FragColor = texture2D(uTexture, gl_PointCoord);\n"
+        "       gl_FragColor = texture2D(uTexture, uRegion.xy + gl_PointCoord * uRegion.zw);\n"
         "}";
 
 status StarField::load() {
@@ -50,9 +56,9 @@ status StarField::load() {
     //1 vertices composed of 3 floats (X/Y/Z) per point.
     Vertex *vertexBuffer = new Vertex[mStarCount];
     for (int i = 0; i < mStarCount; ++i) {
-        vertexBuffer[i].x = RAND(mGraphicsManager.getRenderWidth());
-        vertexBuffer[i].y = RAND(mGraphicsManager.getRenderHeight());
-        vertexBuffer[i].z = RAND(1.0f);
+        vertexBuffer[i].x = mRandom.nextFloat(mGraphicsManager.getRenderWidth());
+        vertexBuffer[i].y = mRandom.nextFloat(mGraphicsManager.getRenderHeight());
+        vertexBuffer[i].z = mRandom.nextFloat();
     }
 
     //Loads the vertex buffer into OpenGL.
@@ -64,6 +70,11 @@ status StarField::load() {
     textureProperties = mGraphicsManager.loadTexture(mTextureResource);
     if (textureProperties == NULL) goto ERROR;
     mTexture = textureProperties->texture;
+    //Area of the star in its texture: origin then size.
+    mRegion[0] = textureProperties->u1;
+    mRegion[1] = textureProperties->v1;
+    mRegion[2] = textureProperties->u2 - textureProperties->u1;
+    mRegion[3] = textureProperties->v2 - textureProperties->v1;
 
     //Creates and retrieves shader attributes and uniforms.
     mShaderProgram = mGraphicsManager.loadShader(VERTEX_SHADER, FRAGMENT_SHADER);
@@ -73,6 +84,7 @@ status StarField::load() {
     uHeight = glGetUniformLocation(mShaderProgram, "uHeight");
     uTime = glGetUniformLocation(mShaderProgram, "uTime");
     uTexture = glGetUniformLocation(mShaderProgram, "uTexture");
+    uRegion = glGetUniformLocation(mShaderProgram, "uRegion");
     return STATUS_OK;
 
     ERROR:
@@ -103,6 +115,7 @@ void StarField::draw() {
     glUniform1f(uHeight, mGraphicsManager.getRenderHeight());
     glUniform1f(uTime, mTimeManager.elapsedTotal());
     glUniform1i(uTexture, 0);
+    glUniform4fv(uRegion, 1, mRegion);
 
     //Renders the star field.
     glDrawArrays(GL_POINTS, 0, mStarCount);
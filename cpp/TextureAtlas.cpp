@@ -0,0 +1,105 @@
+//
+// Created by cjf12 on 2019-11-12.
+//
+
+#include "include/TextureAtlas.h"
+#include "include/Log.h"
+
+#include <algorithm>
+
+static int32_t nextPowerOfTwo(int32_t pValue) {
+    int32_t power = 1;
+    while (power < pValue) power <<= 1;
+    return power;
+}
+
+//Tallest sheets first, which keeps shelves tight.
+class TallerSheet {
+public:
+    TallerSheet(const std::vector<Image> &pImages) : mImages(pImages) {}
+
+    bool operator()(int32_t pSheet1, int32_t pSheet2) const {
+        return mImages[pSheet1].height > mImages[pSheet2].height;
+    }
+
+private:
+    const std::vector<Image> &mImages;
+};
+
+TextureAtlas::TextureAtlas(int32_t pMaxSize, int32_t pPadding) :
+        mMaxSize(pMaxSize), mPadding(pPadding),
+        mSheets(), mRegions(), mPages() {
+}
+
+void TextureAtlas::addSheet(Resource &pResource) {
+    if (findSheet(pResource) >= 0) return;
+    mSheets.push_back(&pResource);
+}
+
+int32_t TextureAtlas::findSheet(Resource &pResource) {
+    for (int i = 0; i < int32_t(mSheets.size()); ++i) {
+        if (mSheets[i] == &pResource) return i;
+    }
+    return -1;
+}
+
+status TextureAtlas::layout(const std::vector<Image> &pSizes) {
+    int32_t sheetCount = mSheets.size();
+    const std::vector<Image> &images = pSizes;
+    std::vector<int32_t> order(sheetCount);
+    if (int32_t(pSizes.size()) != sheetCount) return STATUS_KO;
+    for (int i = 0; i < sheetCount; ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), TallerSheet(images));
+
+    //Places sheets on shelves, left to right then bottom to top, opening
+    //a new page when one is full. Page sizes are then trimmed to the
+    //used area, rounded to powers of two.
+    mRegions.assign(sheetCount, Region());
+    std::vector<int32_t> pageWidths, pageHeights;
+    int32_t page = -1, x = 0, y = 0, shelfHeight = 0;
+    for (int i = 0; i < sheetCount; ++i) {
+        Region &region = mRegions[order[i]];
+        region.width = images[order[i]].width;
+        region.height = images[order[i]].height;
+        region.page = -1;
+        int32_t width = region.width + mPadding, height = region.height + mPadding;
+        //Sheets without size, e.g. compressed, are loaded on their own.
+        if ((region.width <= 0) || (region.height <= 0)) continue;
+        if ((region.width > mMaxSize) || (region.height > mMaxSize)) {
+            Log::warn("Sheet %s does not fit in the atlas.", mSheets[order[i]]->getPath());
+            continue;
+        }
+
+        if ((page >= 0) && (x + region.width > mMaxSize)) {
+            y += shelfHeight;
+            x = 0;
+            shelfHeight = 0;
+        }
+        if ((page < 0) || (y + region.height > mMaxSize)) {
+            ++page;
+            pageWidths.push_back(0);
+            pageHeights.push_back(0);
+            x = 0;
+            y = 0;
+            shelfHeight = 0;
+        }
+        region.page = page;
+        region.x = x;
+        region.y = y;
+        pageWidths[page] = std::max(pageWidths[page], x + region.width);
+        pageHeights[page] = std::max(pageHeights[page], y + region.height);
+        x += width;
+        shelfHeight = std::max(shelfHeight, height);
+    }
+
+    mPages.assign(page + 1, Image());
+    for (int i = 0; i <= page; ++i) {
+        mPages[i].width = nextPowerOfTwo(pageWidths[i]);
+        mPages[i].height = nextPowerOfTwo(pageHeights[i]);
+        mPages[i].format = GL_RGBA;
+    }
+    Log::info("Laid %d sheets out in %d atlas pages.", sheetCount, page + 1);
+    return STATUS_OK;
+}
@@ -4,16 +4,19 @@
 
 #include "include/TimeManager.h"
 #include "include/Log.h"
-#include <cstdlib>
 #include <time.h>
 
+//When positive, now() advances by this fixed amount on each call instead of
+//reading the monotonic clock, giving reproducible frame steps.
+static double sFixedStep = 0.0;
+static double sFixedTime = 0.0;
+
 
 TimeManager::TimeManager() :
         mFirstTime(0.0f),
         mLastTime(0.0f),
         mElapsed(0.0f),
         mElapsedTotal(0.0f) {
-    srand(time(NULL));
 }
 
 void TimeManager::reset() {
@@ -30,7 +33,16 @@ void TimeManager::update() {
     mLastTime = currentTime;
 }
 
+void TimeManager::useFixedStep(double pStep) {
+    sFixedStep = pStep;
+    sFixedTime = 0.0;
+}
+
 double TimeManager::now() {
+    if (sFixedStep > 0.0) {
+        sFixedTime += sFixedStep;
+        return sFixedTime;
+    }
     timespec timeVal;
     clock_gettime(CLOCK_MONOTONIC, &timeVal);
     return timeVal.tv_sec + (timeVal.tv_nsec * 1.0e-9);
@@ -0,0 +1,287 @@
+//
+// Created by cjf12 on 2019-11-03.
+//
+// Frame-step micro-benchmark. Drives DroidBlaster::onStep() on the host
+// build with a fixed synthetic clock and reports per-stage p50/p99/max
+// times, heap allocations per frame and what reached the null GL driver.
+// Allocations are those of the game thread only: decode workers run
+// concurrently and are not charged to the frame.
+//
+// Usage: droidblasterbench [--frames N] [--warmup N] [--asteroids N]
+//                          [--stars N] [--sprites N] [--step SECONDS]
+//                          [--physics-hz HZ] [--kinematic 0|1] [--seed N]
+//                          [--atlas 0|1] [--instanced 0|1]
+//                          [--gl-extensions LIST] [--image-cache BYTES]
+//
+
+#include "include/DroidBlaster.h"
+#include "include/GameSettings.h"
+#include "include/Profiler.h"
+#include "include/TimeManager.h"
+#include "host/include/HostPlatform.h"
+#include "Libraries/libpng/png.h"
+
+#include <algorithm>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+static const int32_t SCREEN_WIDTH = 1080;
+static const int32_t SCREEN_HEIGHT = 1920;
+
+//Counts heap allocations per thread, so that workers neither race on the
+//counter nor show up in the frames measured on the main thread.
+static thread_local int64_t sAllocationCount = 0;
+
+void *operator new(size_t pSize) {
+    ++sAllocationCount;
+    void *memory = malloc(pSize != 0 ? pSize : 1);
+    if (memory == NULL) throw std::bad_alloc();
+    return memory;
+}
+
+void *operator new[](size_t pSize) {
+    return operator new(pSize);
+}
+
+void operator delete(void *pMemory) noexcept {
+    free(pMemory);
+}
+
+void operator delete[](void *pMemory) noexcept {
+    free(pMemory);
+}
+
+struct BenchOptions {
+    int32_t frames;
+    int32_t warmup;
+    double step;
+    const char *glExtensions;
+    GameSettings settings;
+};
+
+static double now() {
+    timespec timeVal;
+    clock_gettime(CLOCK_MONOTONIC, &timeVal);
+    return timeVal.tv_sec + (timeVal.tv_nsec * 1.0e-9);
+}
+
+static bool parseOptions(int pArgc, char **pArgv, BenchOptions &pOptions) {
+    for (int i = 1; i < pArgc; ++i) {
+        if (i + 1 >= pArgc) return false;
+        const char *name = pArgv[i];
+        const char *value = pArgv[++i];
+        if (strcmp(name, "--frames") == 0) {
+            pOptions.frames = atoi(value);
+        } else if (strcmp(name, "--warmup") == 0) {
+            pOptions.warmup = atoi(value);
+        } else if (strcmp(name, "--asteroids") == 0) {
+            pOptions.settings.asteroidCount = atoi(value);
+        } else if (strcmp(name, "--stars") == 0) {
+            pOptions.settings.starCount = atoi(value);
+        } else if (strcmp(name, "--sprites") == 0) {
+            pOptions.settings.extraSpriteCount = atoi(value);
+        } else if (strcmp(name, "--physics-hz") == 0) {
+            pOptions.settings.physicsFrequency = float(atof(value));
+        } else if (strcmp(name, "--kinematic") == 0) {
+            pOptions.settings.kinematicAsteroids = atoi(value) != 0;
+        } else if (strcmp(name, "--seed") == 0) {
+            pOptions.settings.randomSeed = strtoull(value, NULL, 10);
+        } else if (strcmp(name, "--atlas") == 0) {
+            pOptions.settings.textureAtlas = atoi(value) != 0;
+        } else if (strcmp(name, "--instanced") == 0) {
+            pOptions.settings.instancedSprites = atoi(value) != 0;
+        } else if (strcmp(name, "--gl-extensions") == 0) {
+            pOptions.glExtensions = value;
+        } else if (strcmp(name, "--image-cache") == 0) {
+            pOptions.settings.imageCacheBudget = strtoll(value, NULL, 10);
+        } else if (strcmp(name, "--step") == 0) {
+            pOptions.step = atof(value);
+        } else {
+            return false;
+        }
+    }
+    return pOptions.frames > 0;
+}
+
+//Writes an opaque RGBA sprite sheet so textures load without shipped assets.
+static bool writeSheet(const std::string &pPath, int32_t pWidth, int32_t pHeight) {
+    FILE *file = fopen(pPath.c_str(), "wb");
+    if (file == NULL) return false;
+    png_structp pngPtr = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+    png_infop infoPtr = png_create_info_struct(pngPtr);
+    if (setjmp(png_jmpbuf(pngPtr))) {
+        png_destroy_write_struct(&pngPtr, &infoPtr);
+        fclose(file);
+        return false;
+    }
+    png_init_io(pngPtr, file);
+    png_set_IHDR(pngPtr, infoPtr, pWidth, pHeight, 8, PNG_COLOR_TYPE_RGBA,
+                 PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+    png_write_info(pngPtr, infoPtr);
+    std::vector<png_byte> row(pWidth * 4, 0xFF);
+    for (int i = 0; i < pHeight; ++i) {
+        png_write_row(pngPtr, &row[0]);
+    }
+    png_write_end(pngPtr, NULL);
+    png_destroy_write_struct(&pngPtr, &infoPtr);
+    fclose(file);
+    return true;
+}
+
+//Files written by prepareAssets(), under droidblaster/.
+static const char *ASSET_FILES[] = {"asteroid.png", "ship.png", "star.png", "collision.pcm"};
+
+//Removes the scratch directory of prepareAssets() and what it contains.
+static void cleanupAssets(const std::string &pRoot) {
+    if (pRoot.empty()) return;
+    if (chdir("/") != 0) return;
+    std::string directory = pRoot + "/droidblaster";
+    for (size_t i = 0; i < sizeof(ASSET_FILES) / sizeof(ASSET_FILES[0]); ++i) {
+        unlink((directory + "/" + ASSET_FILES[i]).c_str());
+    }
+    rmdir(directory.c_str());
+    rmdir(pRoot.c_str());
+}
+
+//Creates droidblaster/ assets in a scratch directory and moves into it
+//(the host asset root defaults to the working directory).
+static bool prepareAssets(std::string &pRoot) {
+    char root[] = "/tmp/droidblasterbench.XXXXXX";
+    if (mkdtemp(root) == NULL) return false;
+    pRoot = root;
+    std::string directory = std::string(root) + "/droidblaster";
+    if (mkdir(directory.c_str(), 0700) != 0) return false;
+    if (!writeSheet(directory + "/asteroid.png", 256, 256)) return false;
+    if (!writeSheet(directory + "/ship.png", 320, 256)) return false;
+    if (!writeSheet(directory + "/star.png", 32, 32)) return false;
+
+    FILE *file = fopen((directory + "/collision.pcm").c_str(), "wb");
+    if (file == NULL) return false;
+    std::vector<char> silence(4096, 0);
+    fwrite(&silence[0], 1, silence.size(), file);
+    fclose(file);
+    return chdir(root) == 0;
+}
+
+static double percentile(std::vector<double> &pSamples, double pRank) {
+    if (pSamples.empty()) return 0.0;
+    std::sort(pSamples.begin(), pSamples.end());
+    size_t index = size_t(pRank * (pSamples.size() - 1) + 0.5);
+    return pSamples[index];
+}
+
+static void report(const char *pName, std::vector<double> &pSamples) {
+    printf("%-18s %10.2f %10.2f %10.2f\n", pName,
+           percentile(pSamples, 0.50) * 1.0e6,
+           percentile(pSamples, 0.99) * 1.0e6,
+           percentile(pSamples, 1.0) * 1.0e6);
+}
+
+int main(int pArgc, char **pArgv) {
+    BenchOptions options;
+    options.frames = 1000;
+    options.warmup = 60;
+    options.step = 1.0 / 60.0;
+    options.glExtensions = "";
+    //Runs are reproducible unless asked otherwise.
+    options.settings.randomSeed = 1;
+    //Fixed physics steps, so that the step cost does not depend on --step.
+    options.settings.physicsFrequency = 60.0f;
+    if (!parseOptions(pArgc, pArgv, options)) {
+        fprintf(stderr, "Usage: %s [--frames N] [--warmup N] [--asteroids N] [--stars N] "
+                        "[--sprites N] [--step SECONDS] [--physics-hz HZ] "
+                        "[--kinematic 0|1] [--seed N] [--atlas 0|1] [--instanced 0|1] "
+                        "[--gl-extensions LIST] [--image-cache BYTES]\n", pArgv[0]);
+        return 1;
+    }
+    std::string assetRoot;
+    if (!prepareAssets(assetRoot)) {
+        fprintf(stderr, "Could not create benchmark assets\n");
+        cleanupAssets(assetRoot);
+        return 1;
+    }
+
+    TimeManager::useFixedStep(options.step);
+    HostPlatform::setGLExtensions(options.glExtensions);
+    android_app *application = HostPlatform::createApplication(SCREEN_WIDTH, SCREEN_HEIGHT);
+    int32_t exitCode = 0;
+    {
+        DroidBlaster droidBlaster(application, options.settings);
+        //Lifecycle callbacks are driven the way EventLoop does, through the handler.
+        ActivityHandler &handler = droidBlaster;
+        if (handler.onActivate() != STATUS_OK) {
+            fprintf(stderr, "Could not activate DroidBlaster\n");
+            exitCode = 1;
+        } else {
+            std::vector<double> stageSamples[Profiler::STAGE_COUNT];
+            std::vector<double> frameSamples;
+            int64_t totalAllocations = 0, maxAllocations = 0;
+            int64_t drawCalls = 0, textureBinds = 0, clientArrayBytes = 0;
+            int64_t bufferUploadBytes = 0;
+            int32_t restarts = 0;
+
+            for (int i = 0; i < options.warmup + options.frames; ++i) {
+                HostPlatform::resetGLStats();
+                int64_t allocations = sAllocationCount;
+                double frameStart = now();
+                status result = handler.onStep();
+                double frameTime = now() - frameStart;
+                allocations = sAllocationCount - allocations;
+
+                if (result != STATUS_OK) {
+                    //Ship destroyed: restart the level, the frame is not representative.
+                    ++restarts;
+                    handler.onDeactivate();
+                    if (handler.onActivate() != STATUS_OK) {
+                        exitCode = 1;
+                        break;
+                    }
+                    continue;
+                }
+                if (i < options.warmup) continue;
+
+                for (int j = 0; j < Profiler::STAGE_COUNT; ++j) {
+                    stageSamples[j].push_back(Profiler::getStageTime(Profiler::Stage(j)));
+                }
+                frameSamples.push_back(frameTime);
+                totalAllocations += allocations;
+                maxAllocations = std::max(maxAllocations, allocations);
+                drawCalls += HostPlatform::getGLStats().drawCalls;
+                textureBinds += HostPlatform::getGLStats().textureBinds;
+                clientArrayBytes += HostPlatform::getGLStats().clientArrayBytes;
+                bufferUploadBytes += HostPlatform::getGLStats().bufferUploadBytes;
+            }
+
+            size_t sampleCount = std::max<size_t>(frameSamples.size(), 1);
+            printf("asteroids=%d%s stars=%d sprites=%d frames=%zu step=%.4fs restarts=%d\n",
+                   options.settings.asteroidCount,
+                   options.settings.kinematicAsteroids ? " (kinematic)" : "",
+                   options.settings.starCount,
+                   options.settings.extraSpriteCount, frameSamples.size(), options.step,
+                   restarts);
+            printf("%-18s %10s %10s %10s\n", "stage (us)", "p50", "p99", "max");
+            for (int j = 0; j < Profiler::STAGE_COUNT; ++j) {
+                report(Profiler::getStageName(Profiler::Stage(j)), stageSamples[j]);
+            }
+            report("frame", frameSamples);
+            printf("allocs/frame (main) mean %.2f max %lld\n",
+                   double(totalAllocations) / sampleCount, (long long) maxAllocations);
+            printf("gl/frame           draws %.2f binds %.2f client bytes %.0f "
+                   "upload bytes %.0f\n",
+                   double(drawCalls) / sampleCount, double(textureBinds) / sampleCount,
+                   double(clientArrayBytes) / sampleCount,
+                   double(bufferUploadBytes) / sampleCount);
+            handler.onDeactivate();
+        }
+    }
+    HostPlatform::destroyApplication(application);
+    cleanupAssets(assetRoot);
+    return exitCode;
+}
@@ -0,0 +1,440 @@
+//
+// Created by cjf12 on 2019-11-02.
+//
+// Null EGL and recording GLES 2 backend for the host build. Nothing is
+// rendered: calls only update HostGLStats so batching changes can be
+// compared (draw calls, binds, bytes crossing the driver boundary).
+//
+
+#include "include/HostPlatform.h"
+#include <EGL/egl.h>
+#include <GLES2/gl2.h>
+#include <GLES2/gl2ext.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+static const int32_t MAX_VERTEX_ATTRIBS = 16;
+static const GLenum HOST_PROGRAM_BINARY_FORMAT = 0x484F5354; // "HOST"
+static const GLint HOST_PROGRAM_BINARY_LENGTH = 16;
+
+struct HostVertexAttrib {
+    bool enabled;
+    bool clientArray;
+    GLsizei stride;
+};
+
+static HostGLStats sGLStats;
+static const char *sExtensions = "";
+static GLuint sNextName = 1;
+static GLuint sArrayBuffer = 0;
+static GLuint sElementArrayBuffer = 0;
+static GLuint sTexture = 0;
+static GLuint sProgram = 0;
+static HostVertexAttrib sAttribs[MAX_VERTEX_ATTRIBS];
+static std::vector<std::string> sAttribNames;
+
+void HostPlatform::setGLExtensions(const char *pExtensions) {
+    sExtensions = pExtensions;
+}
+
+const HostGLStats &HostPlatform::getGLStats() {
+    return sGLStats;
+}
+
+void HostPlatform::resetGLStats() {
+    memset(&sGLStats, 0, sizeof(sGLStats));
+}
+
+static void genNames(GLsizei pCount, GLuint *pNames) {
+    for (int i = 0; i < pCount; ++i) {
+        pNames[i] = sNextName++;
+    }
+}
+
+//EGL.
+EGLDisplay eglGetDisplay(EGLNativeDisplayType pDisplayId) {
+    return (EGLDisplay) &sGLStats;
+}
+
+EGLBoolean eglInitialize(EGLDisplay pDisplay, EGLint *pMajor, EGLint *pMinor) {
+    if (pMajor != NULL) *pMajor = 1;
+    if (pMinor != NULL) *pMinor = 4;
+    return EGL_TRUE;
+}
+
+EGLBoolean eglTerminate(EGLDisplay pDisplay) {
+    return EGL_TRUE;
+}
+
+EGLBoolean eglChooseConfig(EGLDisplay pDisplay, const EGLint *pAttribs,
+                           EGLConfig *pConfigs, EGLint pConfigSize, EGLint *pNumConfig) {
+    if ((pConfigs != NULL) && (pConfigSize > 0)) pConfigs[0] = (EGLConfig) &sGLStats;
+    *pNumConfig = 1;
+    return EGL_TRUE;
+}
+
+EGLBoolean eglGetConfigAttrib(EGLDisplay pDisplay, EGLConfig pConfig,
+                              EGLint pAttribute, EGLint *pValue) {
+    *pValue = 0;
+    return EGL_TRUE;
+}
+
+EGLSurface eglCreateWindowSurface(EGLDisplay pDisplay, EGLConfig pConfig,
+                                  EGLNativeWindowType pWindow, const EGLint *pAttribs) {
+    return (EGLSurface) pWindow;
+}
+
+EGLBoolean eglDestroySurface(EGLDisplay pDisplay, EGLSurface pSurface) {
+    return EGL_TRUE;
+}
+
+EGLContext eglCreateContext(EGLDisplay pDisplay, EGLConfig pConfig,
+                            EGLContext pShareContext, const EGLint *pAttribs) {
+    return (EGLContext) &sGLStats;
+}
+
+EGLBoolean eglDestroyContext(EGLDisplay pDisplay, EGLContext pContext) {
+    return EGL_TRUE;
+}
+
+EGLBoolean eglMakeCurrent(EGLDisplay pDisplay, EGLSurface pDraw, EGLSurface pRead,
+                          EGLContext pContext) {
+    return EGL_TRUE;
+}
+
+EGLBoolean eglQuerySurface(EGLDisplay pDisplay, EGLSurface pSurface, EGLint pAttribute,
+                           EGLint *pValue) {
+    switch (pAttribute) {
+        case EGL_WIDTH:
+            *pValue = HostPlatform::getScreenWidth();
+            return EGL_TRUE;
+        case EGL_HEIGHT:
+            *pValue = HostPlatform::getScreenHeight();
+            return EGL_TRUE;
+        default:
+            return EGL_FALSE;
+    }
+}
+
+EGLBoolean eglSwapBuffers(EGLDisplay pDisplay, EGLSurface pSurface) {
+    return EGL_TRUE;
+}
+
+EGLint eglGetError() {
+    return EGL_SUCCESS;
+}
+
+static void hostDrawElementsInstanced(GLenum pMode, GLsizei pCount, GLenum pType,
+                                      const void *pIndices, GLsizei pInstanceCount);
+
+static void hostVertexAttribDivisor(GLuint pIndex, GLuint pDivisor);
+
+static void hostGetProgramBinary(GLuint pProgram, GLsizei pBufSize, GLsizei *pLength,
+                                 GLenum *pBinaryFormat, void *pBinary);
+
+static void hostProgramBinary(GLuint pProgram, GLenum pBinaryFormat, const void *pBinary,
+                              GLint pLength);
+
+//Resolves extension entry points. As on devices, a non-NULL result does
+//not mean the extension is advertised.
+__eglMustCastToProperFunctionPointerType eglGetProcAddress(const char *pName) {
+    if ((strcmp(pName, "glDrawElementsInstancedEXT") == 0)
+        || (strcmp(pName, "glDrawElementsInstanced") == 0)) {
+        return (__eglMustCastToProperFunctionPointerType) &hostDrawElementsInstanced;
+    } else if ((strcmp(pName, "glVertexAttribDivisorEXT") == 0)
+               || (strcmp(pName, "glVertexAttribDivisor") == 0)) {
+        return (__eglMustCastToProperFunctionPointerType) &hostVertexAttribDivisor;
+    } else if ((strcmp(pName, "glGetProgramBinaryOES") == 0)
+               || (strcmp(pName, "glGetProgramBinary") == 0)) {
+        return (__eglMustCastToProperFunctionPointerType) &hostGetProgramBinary;
+    } else if ((strcmp(pName, "glProgramBinaryOES") == 0)
+               || (strcmp(pName, "glProgramBinary") == 0)) {
+        return (__eglMustCastToProperFunctionPointerType) &hostProgramBinary;
+    }
+    return NULL;
+}
+
+//GLES 2.
+void glActiveTexture(GLenum pTexture) {}
+
+void glAttachShader(GLuint pProgram, GLuint pShader) {}
+
+void glBindAttribLocation(GLuint pProgram, GLuint pIndex, const GLchar *pName) {}
+
+void glBindBuffer(GLenum pTarget, GLuint pBuffer) {
+    if (pTarget == GL_ARRAY_BUFFER) {
+        sArrayBuffer = pBuffer;
+    } else if (pTarget == GL_ELEMENT_ARRAY_BUFFER) {
+        sElementArrayBuffer = pBuffer;
+    }
+}
+
+void glBindFramebuffer(GLenum pTarget, GLuint pFramebuffer) {}
+
+void glBindTexture(GLenum pTarget, GLuint pTexture) {
+    if (pTexture != sTexture) {
+        ++sGLStats.textureBinds;
+        sTexture = pTexture;
+    }
+}
+
+void glBlendFunc(GLenum pSrcFactor, GLenum pDstFactor) {}
+
+void glBufferData(GLenum pTarget, GLsizeiptr pSize, const void *pData, GLenum pUsage) {
+    if (pData != NULL) sGLStats.bufferUploadBytes += pSize;
+}
+
+void glBufferSubData(GLenum pTarget, GLintptr pOffset, GLsizeiptr pSize, const void *pData) {
+    sGLStats.bufferUploadBytes += pSize;
+}
+
+void glClear(GLbitfield pMask) {}
+
+void glCompileShader(GLuint pShader) {}
+
+void glCompressedTexImage2D(GLenum pTarget, GLint pLevel, GLenum pInternalFormat, GLsizei pWidth,
+                            GLsizei pHeight, GLint pBorder, GLsizei pImageSize,
+                            const void *pData) {
+    if (pData == NULL) return;
+    sGLStats.textureUploadBytes += pImageSize;
+}
+
+GLuint glCreateProgram() {
+    return sNextName++;
+}
+
+GLuint glCreateShader(GLenum pType) {
+    return sNextName++;
+}
+
+void glDeleteBuffers(GLsizei pCount, const GLuint *pBuffers) {}
+
+void glDeleteFramebuffers(GLsizei pCount, const GLuint *pFramebuffers) {}
+
+void glDeleteProgram(GLuint pProgram) {}
+
+void glDeleteShader(GLuint pShader) {}
+
+void glDeleteTextures(GLsizei pCount, const GLuint *pTextures) {}
+
+void glDisable(GLenum pCap) {}
+
+void glDisableVertexAttribArray(GLuint pIndex) {
+    if (pIndex < MAX_VERTEX_ATTRIBS) sAttribs[pIndex].enabled = false;
+}
+
+void glEnable(GLenum pCap) {}
+
+void glEnableVertexAttribArray(GLuint pIndex) {
+    if (pIndex < MAX_VERTEX_ATTRIBS) sAttribs[pIndex].enabled = true;
+}
+
+// A driver has to copy client-side vertex arrays up to the highest
+// referenced vertex on every draw call.
+static void recordClientArrays(int64_t pVertexCount) {
+    for (int i = 0; i < MAX_VERTEX_ATTRIBS; ++i) {
+        if (sAttribs[i].enabled && sAttribs[i].clientArray) {
+            sGLStats.clientArrayBytes += pVertexCount * sAttribs[i].stride;
+        }
+    }
+}
+
+void glDrawArrays(GLenum pMode, GLint pFirst, GLsizei pCount) {
+    ++sGLStats.drawCalls;
+    sGLStats.drawnElements += pCount;
+    recordClientArrays(pFirst + pCount);
+}
+
+//Instanced draws are only used with buffers: no client array to account for.
+static void hostDrawElementsInstanced(GLenum pMode, GLsizei pCount, GLenum pType,
+                                      const void *pIndices, GLsizei pInstanceCount) {
+    ++sGLStats.drawCalls;
+    sGLStats.drawnElements += int64_t(pCount) * pInstanceCount;
+}
+
+void glDrawElements(GLenum pMode, GLsizei pCount, GLenum pType, const void *pIndices) {
+    ++sGLStats.drawCalls;
+    sGLStats.drawnElements += pCount;
+    if (sElementArrayBuffer == 0) {
+        int64_t maxIndex = -1;
+        if (pType == GL_UNSIGNED_SHORT) {
+            const GLushort *indices = (const GLushort *) pIndices;
+            for (int i = 0; i < pCount; ++i) {
+                if (indices[i] > maxIndex) maxIndex = indices[i];
+            }
+            sGLStats.clientArrayBytes += pCount * sizeof(GLushort);
+        } else if (pType == GL_UNSIGNED_INT) {
+            const GLuint *indices = (const GLuint *) pIndices;
+            for (int i = 0; i < pCount; ++i) {
+                if (indices[i] > maxIndex) maxIndex = indices[i];
+            }
+            sGLStats.clientArrayBytes += pCount * sizeof(GLuint);
+        }
+        recordClientArrays(maxIndex + 1);
+    }
+}
+
+void glFramebufferTexture2D(GLenum pTarget, GLenum pAttachment, GLenum pTexTarget,
+                            GLuint pTexture, GLint pLevel) {}
+
+void glGenBuffers(GLsizei pCount, GLuint *pBuffers) {
+    genNames(pCount, pBuffers);
+}
+
+void glGenFramebuffers(GLsizei pCount, GLuint *pFramebuffers) {
+    genNames(pCount, pFramebuffers);
+}
+
+void glGenTextures(GLsizei pCount, GLuint *pTextures) {
+    genNames(pCount, pTextures);
+}
+
+GLint glGetAttribLocation(GLuint pProgram, const GLchar *pName) {
+    //Hands out one stable slot per attribute name.
+    for (size_t i = 0; i < sAttribNames.size(); ++i) {
+        if (sAttribNames[i] == pName) return GLint(i);
+    }
+    if (sAttribNames.size() >= MAX_VERTEX_ATTRIBS) return -1;
+    sAttribNames.push_back(pName);
+    return GLint(sAttribNames.size() - 1);
+}
+
+GLenum glGetError() {
+    return GL_NO_ERROR;
+}
+
+void glGetIntegerv(GLenum pName, GLint *pData) {
+    //A single binary format when program binaries are advertised.
+    *pData = ((pName == GL_NUM_PROGRAM_BINARY_FORMATS_OES)
+              && (strstr(sExtensions, "GL_OES_get_program_binary") != NULL)) ? 1 : 0;
+}
+
+void glGetProgramInfoLog(GLuint pProgram, GLsizei pBufSize, GLsizei *pLength,
+                         GLchar *pInfoLog) {
+    if (pBufSize > 0) pInfoLog[0] = '\0';
+    if (pLength != NULL) *pLength = 0;
+}
+
+void glGetProgramiv(GLuint pProgram, GLenum pName, GLint *pParams) {
+    switch (pName) {
+        case GL_LINK_STATUS:
+            *pParams = GL_TRUE;
+            break;
+        case GL_PROGRAM_BINARY_LENGTH_OES:
+            *pParams = HOST_PROGRAM_BINARY_LENGTH;
+            break;
+        default:
+            *pParams = 0;
+            break;
+    }
+}
+
+void glGetShaderInfoLog(GLuint pShader, GLsizei pBufSize, GLsizei *pLength,
+                        GLchar *pInfoLog) {
+    if (pBufSize > 0) pInfoLog[0] = '\0';
+    if (pLength != NULL) *pLength = 0;
+}
+
+void glGetShaderiv(GLuint pShader, GLenum pName, GLint *pParams) {
+    *pParams = (pName == GL_COMPILE_STATUS) ? GL_TRUE : 0;
+}
+
+const GLubyte *glGetString(GLenum pName) {
+    switch (pName) {
+        case GL_VERSION:
+            return (const GLubyte *) "OpenGL ES 2.0 (host)";
+        case GL_VENDOR:
+            return (const GLubyte *) "DroidBlaster";
+        case GL_RENDERER:
+            return (const GLubyte *) "Null renderer";
+        case GL_EXTENSIONS:
+            return (const GLubyte *) sExtensions;
+        default:
+            return NULL;
+    }
+}
+
+GLint glGetUniformLocation(GLuint pProgram, const GLchar *pName) {
+    return 0;
+}
+
+void glLinkProgram(GLuint pProgram) {}
+
+void glPixelStorei(GLenum pName, GLint pParam) {}
+
+void glShaderSource(GLuint pShader, GLsizei pCount, const GLchar *const *pString,
+                    const GLint *pLength) {}
+
+void glTexImage2D(GLenum pTarget, GLint pLevel, GLint pInternalFormat, GLsizei pWidth,
+                  GLsizei pHeight, GLint pBorder, GLenum pFormat, GLenum pType,
+                  const void *pPixels) {
+    if (pPixels == NULL) return;
+    int32_t bytesPerPixel;
+    switch (pFormat) {
+        case GL_RGBA:
+            bytesPerPixel = 4;
+            break;
+        case GL_RGB:
+            bytesPerPixel = (pType == GL_UNSIGNED_SHORT_5_6_5) ? 2 : 3;
+            break;
+        case GL_LUMINANCE_ALPHA:
+            bytesPerPixel = 2;
+            break;
+        default:
+            bytesPerPixel = 1;
+            break;
+    }
+    sGLStats.textureUploadBytes += int64_t(pWidth) * pHeight * bytesPerPixel;
+}
+
+void glTexSubImage2D(GLenum pTarget, GLint pLevel, GLint pXOffset, GLint pYOffset,
+                     GLsizei pWidth, GLsizei pHeight, GLenum pFormat, GLenum pType,
+                     const void *pPixels) {
+    //Counted like a full upload of the same size.
+    glTexImage2D(pTarget, pLevel, pFormat, pWidth, pHeight, 0, pFormat, pType, pPixels);
+}
+
+void glTexParameteri(GLenum pTarget, GLenum pName, GLint pParam) {}
+
+void glUniform1f(GLint pLocation, GLfloat pValue) {}
+
+void glUniform2fv(GLint pLocation, GLsizei pCount, const GLfloat *pValue) {}
+
+void glUniform4fv(GLint pLocation, GLsizei pCount, const GLfloat *pValue) {}
+
+void glUniform1i(GLint pLocation, GLint pValue) {}
+
+void glUniformMatrix4fv(GLint pLocation, GLsizei pCount, GLboolean pTranspose,
+                        const GLfloat *pValue) {}
+
+void glUseProgram(GLuint pProgram) {
+    if ((pProgram != 0) && (pProgram != sProgram)) ++sGLStats.programBinds;
+    sProgram = pProgram;
+}
+
+void glVertexAttrib4fv(GLuint pIndex, const GLfloat *pValue) {}
+
+static void hostVertexAttribDivisor(GLuint pIndex, GLuint pDivisor) {}
+
+//GL_OES_get_program_binary. Binaries are opaque placeholders which any
+//program accepts.
+static void hostGetProgramBinary(GLuint pProgram, GLsizei pBufSize, GLsizei *pLength,
+                                 GLenum *pBinaryFormat, void *pBinary) {
+    GLsizei length = (pBufSize < HOST_PROGRAM_BINARY_LENGTH) ? 0 : HOST_PROGRAM_BINARY_LENGTH;
+    if (length > 0) memset(pBinary, 0, length);
+    if (pLength != NULL) *pLength = length;
+    *pBinaryFormat = HOST_PROGRAM_BINARY_FORMAT;
+}
+
+static void hostProgramBinary(GLuint pProgram, GLenum pBinaryFormat, const void *pBinary,
+                              GLint pLength) {}
+
+void glVertexAttribPointer(GLuint pIndex, GLint pSize, GLenum pType, GLboolean pNormalized,
+                           GLsizei pStride, const void *pPointer) {
+    if (pIndex >= MAX_VERTEX_ATTRIBS) return;
+    sAttribs[pIndex].clientArray = (sArrayBuffer == 0);
+    sAttribs[pIndex].stride = (pStride != 0) ? pStride : GLsizei(pSize * sizeof(GLfloat));
+}
+
+void glViewport(GLint pX, GLint pY, GLsizei pWidth, GLsizei pHeight) {}
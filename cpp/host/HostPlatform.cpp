@@ -0,0 +1,174 @@
+//
+// Created by cjf12 on 2019-11-02.
+//
+
+#include "include/HostPlatform.h"
+#include <android/log.h>
+#include <stdio.h>
+#include <string.h>
+
+static const int32_t DEFAULT_SCREEN_WIDTH = 1080;
+static const int32_t DEFAULT_SCREEN_HEIGHT = 1920;
+
+static int32_t sScreenWidth = DEFAULT_SCREEN_WIDTH;
+static int32_t sScreenHeight = DEFAULT_SCREEN_HEIGHT;
+static int32_t sLogPriority = ANDROID_LOG_WARN;
+
+// Opaque handles only need to be distinct and non-NULL.
+static char sWindow;
+static char sLooper;
+static JavaVM sJavaVM;
+
+android_app *HostPlatform::createApplication(int32_t pScreenWidth, int32_t pScreenHeight) {
+    sScreenWidth = pScreenWidth;
+    sScreenHeight = pScreenHeight;
+
+    ANativeActivity *activity = new ANativeActivity();
+    memset(activity, 0, sizeof(ANativeActivity));
+    activity->vm = &sJavaVM;
+    activity->sdkVersion = 21;
+    activity->internalDataPath = "/tmp";
+    activity->externalDataPath = "/tmp";
+
+    android_app *application = new android_app();
+    memset(application, 0, sizeof(android_app));
+    application->activity = activity;
+    application->looper = (ALooper *) &sLooper;
+    application->window = (ANativeWindow *) &sWindow;
+    return application;
+}
+
+void HostPlatform::destroyApplication(android_app *pApplication) {
+    delete pApplication->activity;
+    delete pApplication;
+}
+
+void HostPlatform::setLogPriority(int32_t pPriority) {
+    sLogPriority = pPriority;
+}
+
+int32_t HostPlatform::getScreenWidth() {
+    return sScreenWidth;
+}
+
+int32_t HostPlatform::getScreenHeight() {
+    return sScreenHeight;
+}
+
+//Native glue and activity.
+void app_dummy() {
+}
+
+void ANativeActivity_finish(ANativeActivity *pActivity) {
+    __android_log_print(ANDROID_LOG_INFO, "HOST", "ANativeActivity_finish()\n");
+}
+
+//Logging.
+int __android_log_vprint(int pPriority, const char *pTag, const char *pFormat, va_list pArgs) {
+    if (pPriority < sLogPriority) return 0;
+    return vfprintf(stderr, pFormat, pArgs);
+}
+
+int __android_log_print(int pPriority, const char *pTag, const char *pFormat, ...) {
+    va_list varArgs;
+    va_start(varArgs, pFormat);
+    int result = __android_log_vprint(pPriority, pTag, pFormat, varArgs);
+    va_end(varArgs);
+    return result;
+}
+
+//Looper. No event source is ever ready on the host.
+int ALooper_pollOnce(int pTimeoutMillis, int *pOutFd, int *pOutEvents, void **pOutData) {
+    return ALOOPER_POLL_TIMEOUT;
+}
+
+int ALooper_pollAll(int pTimeoutMillis, int *pOutFd, int *pOutEvents, void **pOutData) {
+    return ALOOPER_POLL_TIMEOUT;
+}
+
+//Window.
+int32_t ANativeWindow_setBuffersGeometry(ANativeWindow *pWindow, int32_t pWidth,
+                                         int32_t pHeight, int32_t pFormat) {
+    return 0;
+}
+
+//Configuration.
+AConfiguration *AConfiguration_new() {
+    return NULL;
+}
+
+void AConfiguration_delete(AConfiguration *pConfig) {
+}
+
+void AConfiguration_fromAssetManager(AConfiguration *pOut, AAssetManager *pAssetManager) {
+}
+
+int32_t AConfiguration_getSdkVersion(AConfiguration *pConfig) { return 0; }
+
+void AConfiguration_getLanguage(AConfiguration *pConfig, char *pOutLanguage) {}
+
+void AConfiguration_getCountry(AConfiguration *pConfig, char *pOutCountry) {}
+
+int32_t AConfiguration_getOrientation(AConfiguration *pConfig) { return 0; }
+
+int32_t AConfiguration_getDensity(AConfiguration *pConfig) { return 0; }
+
+int32_t AConfiguration_getScreenSize(AConfiguration *pConfig) { return 0; }
+
+int32_t AConfiguration_getScreenLong(AConfiguration *pConfig) { return 0; }
+
+//Input. Events are never produced on the host.
+int32_t AInputEvent_getType(const AInputEvent *pEvent) { return 0; }
+
+int32_t AInputEvent_getSource(const AInputEvent *pEvent) { return 0; }
+
+int32_t AKeyEvent_getAction(const AInputEvent *pEvent) { return 0; }
+
+int32_t AKeyEvent_getKeyCode(const AInputEvent *pEvent) { return 0; }
+
+int32_t AMotionEvent_getAction(const AInputEvent *pEvent) { return 0; }
+
+float AMotionEvent_getX(const AInputEvent *pEvent, size_t pPointerIndex) { return 0.0f; }
+
+float AMotionEvent_getY(const AInputEvent *pEvent, size_t pPointerIndex) { return 0.0f; }
+
+//Sensors. No sensor manager, so EventLoop never creates a queue.
+ASensorManager *ASensorManager_getInstance() {
+    return NULL;
+}
+
+ASensor const *ASensorManager_getDefaultSensor(ASensorManager *pManager, int pType) {
+    return NULL;
+}
+
+ASensorEventQueue *ASensorManager_createEventQueue(ASensorManager *pManager, ALooper *pLooper,
+                                                   int pIdent, ALooper_callbackFunc pCallback,
+                                                   void *pData) {
+    return NULL;
+}
+
+int ASensorManager_destroyEventQueue(ASensorManager *pManager, ASensorEventQueue *pQueue) {
+    return 0;
+}
+
+int ASensorEventQueue_enableSensor(ASensorEventQueue *pQueue, ASensor const *pSensor) {
+    return -1;
+}
+
+int ASensorEventQueue_disableSensor(ASensorEventQueue *pQueue, ASensor const *pSensor) {
+    return 0;
+}
+
+int ASensorEventQueue_setEventRate(ASensorEventQueue *pQueue, ASensor const *pSensor,
+                                   int32_t pMicroSeconds) {
+    return 0;
+}
+
+ssize_t ASensorEventQueue_getEvents(ASensorEventQueue *pQueue, ASensorEvent *pEvents,
+                                    size_t pCount) {
+    return 0;
+}
+
+int ASensor_getMinDelay(ASensor const *pSensor) {
+    return 0;
+}
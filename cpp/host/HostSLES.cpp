@@ -0,0 +1,194 @@
+//
+// Created by cjf12 on 2019-11-02.
+//
+// Null OpenSL ES backend for the host build. Every object realizes
+// successfully and buffer queues only record what was enqueued.
+//
+
+#include "include/HostPlatform.h"
+#include <SLES/OpenSLES.h>
+#include <SLES/OpenSLES_Android.h>
+#include <string.h>
+
+static HostSLStats sSLStats;
+
+static const struct SLInterfaceID_ IID_ENGINE = {1};
+static const struct SLInterfaceID_ IID_PLAY = {2};
+static const struct SLInterfaceID_ IID_SEEK = {3};
+static const struct SLInterfaceID_ IID_RECORD = {4};
+static const struct SLInterfaceID_ IID_BUFFERQUEUE = {5};
+static const struct SLInterfaceID_ IID_ANDROIDSIMPLEBUFFERQUEUE = {6};
+
+const SLInterfaceID SL_IID_ENGINE = &IID_ENGINE;
+const SLInterfaceID SL_IID_PLAY = &IID_PLAY;
+const SLInterfaceID SL_IID_SEEK = &IID_SEEK;
+const SLInterfaceID SL_IID_RECORD = &IID_RECORD;
+const SLInterfaceID SL_IID_BUFFERQUEUE = &IID_BUFFERQUEUE;
+const SLInterfaceID SL_IID_ANDROIDSIMPLEBUFFERQUEUE = &IID_ANDROIDSIMPLEBUFFERQUEUE;
+
+const HostSLStats &HostPlatform::getSLStats() {
+    return sSLStats;
+}
+
+void HostPlatform::resetSLStats() {
+    memset(&sSLStats, 0, sizeof(sSLStats));
+}
+
+//Play, seek and record interfaces.
+static SLresult play_SetPlayState(SLPlayItf pSelf, SLuint32 pState) {
+    return SL_RESULT_SUCCESS;
+}
+
+static SLresult play_GetPlayState(SLPlayItf pSelf, SLuint32 *pState) {
+    *pState = SL_PLAYSTATE_STOPPED;
+    return SL_RESULT_SUCCESS;
+}
+
+static SLresult seek_SetLoop(SLSeekItf pSelf, SLboolean pLoopEnable,
+                             SLmillisecond pStartPos, SLmillisecond pEndPos) {
+    return SL_RESULT_SUCCESS;
+}
+
+static SLresult record_SetRecordState(SLRecordItf pSelf, SLuint32 pState) {
+    return SL_RESULT_SUCCESS;
+}
+
+static SLresult record_SetCallbackEventsMask(SLRecordItf pSelf, SLuint32 pEventFlags) {
+    return SL_RESULT_SUCCESS;
+}
+
+static const struct SLPlayItf_ sPlayItf = {play_SetPlayState, play_GetPlayState};
+static const struct SLPlayItf_ *sPlayItfPtr = &sPlayItf;
+static const struct SLSeekItf_ sSeekItf = {seek_SetLoop};
+static const struct SLSeekItf_ *sSeekItfPtr = &sSeekItf;
+static const struct SLRecordItf_ sRecordItf = {record_SetRecordState,
+                                               record_SetCallbackEventsMask};
+static const struct SLRecordItf_ *sRecordItfPtr = &sRecordItf;
+
+//Buffer queues.
+static SLresult queue_Enqueue(SLBufferQueueItf pSelf, const void *pBuffer, SLuint32 pSize) {
+    ++sSLStats.enqueuedBuffers;
+    sSLStats.enqueuedBytes += pSize;
+    return SL_RESULT_SUCCESS;
+}
+
+static SLresult queue_Clear(SLBufferQueueItf pSelf) {
+    return SL_RESULT_SUCCESS;
+}
+
+static SLresult androidQueue_Enqueue(SLAndroidSimpleBufferQueueItf pSelf, const void *pBuffer,
+                                     SLuint32 pSize) {
+    ++sSLStats.enqueuedBuffers;
+    sSLStats.enqueuedBytes += pSize;
+    return SL_RESULT_SUCCESS;
+}
+
+static SLresult androidQueue_Clear(SLAndroidSimpleBufferQueueItf pSelf) {
+    return SL_RESULT_SUCCESS;
+}
+
+static SLresult androidQueue_RegisterCallback(SLAndroidSimpleBufferQueueItf pSelf,
+                                              slAndroidSimpleBufferQueueCallback pCallback,
+                                              void *pContext) {
+    return SL_RESULT_SUCCESS;
+}
+
+static const struct SLBufferQueueItf_ sQueueItf = {queue_Enqueue, queue_Clear};
+static const struct SLBufferQueueItf_ *sQueueItfPtr = &sQueueItf;
+static const struct SLAndroidSimpleBufferQueueItf_ sAndroidQueueItf = {
+        androidQueue_Enqueue, androidQueue_Clear, androidQueue_RegisterCallback};
+static const struct SLAndroidSimpleBufferQueueItf_ *sAndroidQueueItfPtr = &sAndroidQueueItf;
+
+//Objects. The interface table must stay the first member so that an
+//SLObjectItf can point directly at the object.
+struct HostSLObject {
+    const struct SLObjectItf_ *itf;
+    SLuint32 state;
+};
+
+static SLresult object_Realize(SLObjectItf pSelf, SLboolean pAsync);
+static SLresult object_GetState(SLObjectItf pSelf, SLuint32 *pState);
+static SLresult object_GetInterface(SLObjectItf pSelf, const SLInterfaceID pIID,
+                                    void *pInterface);
+static void object_Destroy(SLObjectItf pSelf);
+
+static const struct SLObjectItf_ sObjectItf = {
+        object_Realize, object_GetState, object_GetInterface, object_Destroy};
+
+static SLObjectItf newObject() {
+    HostSLObject *object = new HostSLObject();
+    object->itf = &sObjectItf;
+    object->state = SL_OBJECT_STATE_UNREALIZED;
+    return &object->itf;
+}
+
+static SLresult engine_CreateAudioPlayer(SLEngineItf pSelf, SLObjectItf *pPlayer,
+                                         SLDataSource *pAudioSrc, SLDataSink *pAudioSnk,
+                                         SLuint32 pNumInterfaces,
+                                         const SLInterfaceID *pInterfaceIds,
+                                         const SLboolean *pInterfaceRequired) {
+    *pPlayer = newObject();
+    return SL_RESULT_SUCCESS;
+}
+
+static SLresult engine_CreateAudioRecorder(SLEngineItf pSelf, SLObjectItf *pRecorder,
+                                           SLDataSource *pAudioSrc, SLDataSink *pAudioSnk,
+                                           SLuint32 pNumInterfaces,
+                                           const SLInterfaceID *pInterfaceIds,
+                                           const SLboolean *pInterfaceRequired) {
+    *pRecorder = newObject();
+    return SL_RESULT_SUCCESS;
+}
+
+static SLresult engine_CreateOutputMix(SLEngineItf pSelf, SLObjectItf *pMix,
+                                       SLuint32 pNumInterfaces,
+                                       const SLInterfaceID *pInterfaceIds,
+                                       const SLboolean *pInterfaceRequired) {
+    *pMix = newObject();
+    return SL_RESULT_SUCCESS;
+}
+
+static const struct SLEngineItf_ sEngineItf = {
+        engine_CreateAudioPlayer, engine_CreateAudioRecorder, engine_CreateOutputMix};
+static const struct SLEngineItf_ *sEngineItfPtr = &sEngineItf;
+
+static SLresult object_Realize(SLObjectItf pSelf, SLboolean pAsync) {
+    ((HostSLObject *) pSelf)->state = SL_OBJECT_STATE_REALIZED;
+    return SL_RESULT_SUCCESS;
+}
+
+static SLresult object_GetState(SLObjectItf pSelf, SLuint32 *pState) {
+    *pState = ((HostSLObject *) pSelf)->state;
+    return SL_RESULT_SUCCESS;
+}
+
+static SLresult object_GetInterface(SLObjectItf pSelf, const SLInterfaceID pIID,
+                                    void *pInterface) {
+    if (pIID == SL_IID_ENGINE) {
+        *(SLEngineItf *) pInterface = &sEngineItfPtr;
+    } else if (pIID == SL_IID_PLAY) {
+        *(SLPlayItf *) pInterface = &sPlayItfPtr;
+    } else if (pIID == SL_IID_SEEK) {
+        *(SLSeekItf *) pInterface = &sSeekItfPtr;
+    } else if (pIID == SL_IID_RECORD) {
+        *(SLRecordItf *) pInterface = &sRecordItfPtr;
+    } else if (pIID == SL_IID_BUFFERQUEUE) {
+        *(SLBufferQueueItf *) pInterface = &sQueueItfPtr;
+    } else if (pIID == SL_IID_ANDROIDSIMPLEBUFFERQUEUE) {
+        *(SLAndroidSimpleBufferQueueItf *) pInterface = &sAndroidQueueItfPtr;
+    } else {
+        return SL_RESULT_FEATURE_UNSUPPORTED;
+    }
+    return SL_RESULT_SUCCESS;
+}
+
+static void object_Destroy(SLObjectItf pSelf) {
+    delete (HostSLObject *) pSelf;
+}
+
+SLresult slCreateEngine(SLObjectItf *pEngine, SLuint32 pNumOptions, const void *pEngineOptions,
+                        SLuint32 pNumInterfaces, const SLInterfaceID *pInterfaceIds,
+                        const SLboolean *pInterfaceRequired) {
+    *pEngine = newObject();
+    return SL_RESULT_SUCCESS;
+}
@@ -0,0 +1,72 @@
+//
+// Created by cjf12 on 2019-11-02.
+//
+// Host stand-in for <EGL/egl.h>. The null display always succeeds and
+// reports the surface size configured through HostPlatform.
+//
+
+#ifndef DROIDBLASTER_HOST_EGL_H
+#define DROIDBLASTER_HOST_EGL_H
+
+#include <stdint.h>
+#include <android/native_window.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef int32_t EGLint;
+typedef unsigned int EGLBoolean;
+typedef void *EGLDisplay;
+typedef void *EGLConfig;
+typedef void *EGLSurface;
+typedef void *EGLContext;
+typedef void *EGLNativeDisplayType;
+typedef ANativeWindow *EGLNativeWindowType;
+typedef void (*__eglMustCastToProperFunctionPointerType)(void);
+
+#define EGL_FALSE                 0
+#define EGL_TRUE                  1
+#define EGL_DEFAULT_DISPLAY       ((EGLNativeDisplayType) 0)
+#define EGL_NO_CONTEXT            ((EGLContext) 0)
+#define EGL_NO_DISPLAY            ((EGLDisplay) 0)
+#define EGL_NO_SURFACE            ((EGLSurface) 0)
+
+#define EGL_SUCCESS               0x3000
+#define EGL_BLUE_SIZE             0x3022
+#define EGL_GREEN_SIZE            0x3023
+#define EGL_RED_SIZE              0x3024
+#define EGL_NATIVE_VISUAL_ID      0x302E
+#define EGL_SURFACE_TYPE          0x3033
+#define EGL_NONE                  0x3038
+#define EGL_RENDERABLE_TYPE       0x3040
+#define EGL_HEIGHT                0x3056
+#define EGL_WIDTH                 0x3057
+#define EGL_CONTEXT_CLIENT_VERSION 0x3098
+#define EGL_WINDOW_BIT            0x0004
+#define EGL_OPENGL_ES2_BIT        0x0004
+
+EGLDisplay eglGetDisplay(EGLNativeDisplayType display_id);
+EGLBoolean eglInitialize(EGLDisplay dpy, EGLint *major, EGLint *minor);
+EGLBoolean eglTerminate(EGLDisplay dpy);
+EGLBoolean eglChooseConfig(EGLDisplay dpy, const EGLint *attrib_list,
+                           EGLConfig *configs, EGLint config_size, EGLint *num_config);
+EGLBoolean eglGetConfigAttrib(EGLDisplay dpy, EGLConfig config,
+                              EGLint attribute, EGLint *value);
+EGLSurface eglCreateWindowSurface(EGLDisplay dpy, EGLConfig config,
+                                  EGLNativeWindowType win, const EGLint *attrib_list);
+EGLBoolean eglDestroySurface(EGLDisplay dpy, EGLSurface surface);
+EGLContext eglCreateContext(EGLDisplay dpy, EGLConfig config,
+                            EGLContext share_context, const EGLint *attrib_list);
+EGLBoolean eglDestroyContext(EGLDisplay dpy, EGLContext ctx);
+EGLBoolean eglMakeCurrent(EGLDisplay dpy, EGLSurface draw, EGLSurface read, EGLContext ctx);
+EGLBoolean eglQuerySurface(EGLDisplay dpy, EGLSurface surface, EGLint attribute, EGLint *value);
+EGLBoolean eglSwapBuffers(EGLDisplay dpy, EGLSurface surface);
+EGLint eglGetError();
+__eglMustCastToProperFunctionPointerType eglGetProcAddress(const char *procname);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DROIDBLASTER_HOST_EGL_H
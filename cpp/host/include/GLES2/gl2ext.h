@@ -0,0 +1,41 @@
+//
+// Created by cjf12 on 2019-11-16.
+//
+// Host stand-in for <GLES2/gl2ext.h>. Only the extensions the engine looks
+// up are declared; entry points are resolved with eglGetProcAddress().
+//
+
+#ifndef DROIDBLASTER_HOST_GLES2EXT_H
+#define DROIDBLASTER_HOST_GLES2EXT_H
+
+#include <GLES2/gl2.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//GL_OES_compressed_ETC1_RGB8_texture.
+#define GL_ETC1_RGB8_OES 0x8D64
+
+//GL_OES_get_program_binary.
+#define GL_PROGRAM_BINARY_LENGTH_OES 0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS_OES 0x87FE
+#define GL_PROGRAM_BINARY_FORMATS_OES 0x87FF
+
+typedef void (*PFNGLGETPROGRAMBINARYOESPROC)(GLuint program, GLsizei bufSize, GLsizei *length,
+                                             GLenum *binaryFormat, void *binary);
+typedef void (*PFNGLPROGRAMBINARYOESPROC)(GLuint program, GLenum binaryFormat,
+                                          const void *binary, GLint length);
+
+//GL_EXT_instanced_arrays.
+#define GL_VERTEX_ATTRIB_ARRAY_DIVISOR_EXT 0x88FE
+
+typedef void (*PFNGLDRAWELEMENTSINSTANCEDEXTPROC)(GLenum mode, GLsizei count, GLenum type,
+                                                  const void *indices, GLsizei primcount);
+typedef void (*PFNGLVERTEXATTRIBDIVISOREXTPROC)(GLuint index, GLuint divisor);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DROIDBLASTER_HOST_GLES2EXT_H
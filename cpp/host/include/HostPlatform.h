@@ -0,0 +1,59 @@
+//
+// Created by cjf12 on 2019-11-02.
+//
+
+#ifndef DROIDBLASTER_HOSTPLATFORM_H
+#define DROIDBLASTER_HOSTPLATFORM_H
+
+#include <android_native_app_glue.h>
+#include <stdint.h>
+
+// What the null GL backend recorded since the last reset. Client-side arrays
+// are accounted for the way a driver would copy them at draw time.
+struct HostGLStats {
+    int32_t drawCalls;
+    int32_t textureBinds;
+    int32_t programBinds;
+    int64_t drawnElements;
+    int64_t clientArrayBytes;
+    int64_t bufferUploadBytes;
+    int64_t textureUploadBytes;
+};
+
+// What the null OpenSL ES backend recorded since the last reset.
+struct HostSLStats {
+    int32_t enqueuedBuffers;
+    int64_t enqueuedBytes;
+};
+
+// Host (x86-64 Linux) replacement for the native_app_glue entry point. Builds
+// an android_app backed by null EGL/GLES/OpenSL ES/looper implementations so
+// the engine can be driven directly (e.g. DroidBlaster::onActivate() then
+// onStep() in a loop) from benchmarks and sanitizer runs.
+class HostPlatform {
+public:
+    static android_app *createApplication(int32_t pScreenWidth, int32_t pScreenHeight);
+
+    static void destroyApplication(android_app *pApplication);
+
+    // Messages below this priority (ANDROID_LOG_*) are dropped. Defaults to
+    // ANDROID_LOG_WARN so per-frame info logging does not skew measurements.
+    static void setLogPriority(int32_t pPriority);
+
+    // Extension string reported by glGetString(GL_EXTENSIONS).
+    static void setGLExtensions(const char *pExtensions);
+
+    static int32_t getScreenWidth();
+
+    static int32_t getScreenHeight();
+
+    static const HostGLStats &getGLStats();
+
+    static void resetGLStats();
+
+    static const HostSLStats &getSLStats();
+
+    static void resetSLStats();
+};
+
+#endif //DROIDBLASTER_HOSTPLATFORM_H
@@ -0,0 +1,183 @@
+//
+// Created by cjf12 on 2019-11-02.
+//
+// Host stand-in for <SLES/OpenSLES.h>. Only the objects and interfaces the
+// SoundManager and SoundQueue use are declared. The null engine realizes
+// every object and swallows enqueued buffers.
+//
+
+#ifndef DROIDBLASTER_HOST_OPENSLES_H
+#define DROIDBLASTER_HOST_OPENSLES_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint8_t SLuint8;
+typedef int16_t SLint16;
+typedef uint16_t SLuint16;
+typedef int32_t SLint32;
+typedef uint32_t SLuint32;
+typedef SLuint32 SLboolean;
+typedef SLuint8 SLchar;
+typedef SLuint32 SLmillisecond;
+typedef SLuint32 SLresult;
+
+#define SL_BOOLEAN_FALSE                   ((SLboolean) 0x00000000)
+#define SL_BOOLEAN_TRUE                    ((SLboolean) 0x00000001)
+#define SL_RESULT_SUCCESS                  ((SLuint32) 0x00000000)
+#define SL_RESULT_PARAMETER_INVALID        ((SLuint32) 0x00000002)
+#define SL_RESULT_FEATURE_UNSUPPORTED      ((SLuint32) 0x0000000C)
+#define SL_TIME_UNKNOWN                    ((SLuint32) 0xFFFFFFFF)
+
+#define SL_OBJECT_STATE_UNREALIZED         ((SLuint32) 0x00000001)
+#define SL_OBJECT_STATE_REALIZED           ((SLuint32) 0x00000002)
+
+#define SL_PLAYSTATE_STOPPED               ((SLuint32) 0x00000001)
+#define SL_PLAYSTATE_PAUSED                ((SLuint32) 0x00000002)
+#define SL_PLAYSTATE_PLAYING               ((SLuint32) 0x00000003)
+
+#define SL_RECORDSTATE_STOPPED             ((SLuint32) 0x00000001)
+#define SL_RECORDSTATE_PAUSED              ((SLuint32) 0x00000002)
+#define SL_RECORDSTATE_RECORDING           ((SLuint32) 0x00000003)
+#define SL_RECORDEVENT_BUFFER_FULL         ((SLuint32) 0x00000020)
+
+#define SL_DATALOCATOR_URI                 ((SLuint32) 0x00000001)
+#define SL_DATALOCATOR_IODEVICE            ((SLuint32) 0x00000003)
+#define SL_DATALOCATOR_OUTPUTMIX           ((SLuint32) 0x00000004)
+#define SL_DATAFORMAT_MIME                 ((SLuint32) 0x00000001)
+#define SL_DATAFORMAT_PCM                  ((SLuint32) 0x00000002)
+#define SL_CONTAINERTYPE_UNSPECIFIED       ((SLuint32) 0x00000001)
+#define SL_IODEVICE_AUDIOINPUT             ((SLuint32) 0x00000001)
+#define SL_DEFAULTDEVICEID_AUDIOINPUT      ((SLuint32) 0xFFFFFFFF)
+
+#define SL_SAMPLINGRATE_44_1               ((SLuint32) 44100000)
+#define SL_PCMSAMPLEFORMAT_FIXED_16        ((SLuint16) 0x0010)
+#define SL_BYTEORDER_LITTLEENDIAN          ((SLuint32) 0x00000002)
+#define SL_SPEAKER_FRONT_LEFT              ((SLuint32) 0x00000001)
+#define SL_SPEAKER_FRONT_RIGHT             ((SLuint32) 0x00000002)
+#define SL_SPEAKER_FRONT_CENTER            ((SLuint32) 0x00000004)
+
+typedef const struct SLInterfaceID_ {
+    SLuint32 time_low;
+} *SLInterfaceID;
+
+extern const SLInterfaceID SL_IID_ENGINE;
+extern const SLInterfaceID SL_IID_PLAY;
+extern const SLInterfaceID SL_IID_SEEK;
+extern const SLInterfaceID SL_IID_RECORD;
+extern const SLInterfaceID SL_IID_BUFFERQUEUE;
+
+struct SLObjectItf_;
+typedef const struct SLObjectItf_ *const *SLObjectItf;
+
+struct SLObjectItf_ {
+    SLresult (*Realize)(SLObjectItf self, SLboolean async);
+    SLresult (*GetState)(SLObjectItf self, SLuint32 *pState);
+    SLresult (*GetInterface)(SLObjectItf self, const SLInterfaceID iid, void *pInterface);
+    void (*Destroy)(SLObjectItf self);
+};
+
+typedef struct SLDataSource_ {
+    void *pLocator;
+    void *pFormat;
+} SLDataSource;
+
+typedef struct SLDataSink_ {
+    void *pLocator;
+    void *pFormat;
+} SLDataSink;
+
+typedef struct SLDataLocator_URI_ {
+    SLuint32 locatorType;
+    SLchar *URI;
+} SLDataLocator_URI;
+
+typedef struct SLDataLocator_OutputMix_ {
+    SLuint32 locatorType;
+    SLObjectItf outputMix;
+} SLDataLocator_OutputMix;
+
+typedef struct SLDataLocator_IODevice_ {
+    SLuint32 locatorType;
+    SLuint32 deviceType;
+    SLuint32 deviceID;
+    SLObjectItf device;
+} SLDataLocator_IODevice;
+
+typedef struct SLDataFormat_MIME_ {
+    SLuint32 formatType;
+    SLchar *mimeType;
+    SLuint32 containerType;
+} SLDataFormat_MIME;
+
+typedef struct SLDataFormat_PCM_ {
+    SLuint32 formatType;
+    SLuint32 numChannels;
+    SLuint32 samplesPerSec;
+    SLuint32 bitsPerSample;
+    SLuint32 containerSize;
+    SLuint32 channelMask;
+    SLuint32 endianness;
+} SLDataFormat_PCM;
+
+struct SLEngineItf_;
+typedef const struct SLEngineItf_ *const *SLEngineItf;
+
+struct SLEngineItf_ {
+    SLresult (*CreateAudioPlayer)(SLEngineItf self, SLObjectItf *pPlayer,
+                                  SLDataSource *pAudioSrc, SLDataSink *pAudioSnk,
+                                  SLuint32 numInterfaces, const SLInterfaceID *pInterfaceIds,
+                                  const SLboolean *pInterfaceRequired);
+    SLresult (*CreateAudioRecorder)(SLEngineItf self, SLObjectItf *pRecorder,
+                                    SLDataSource *pAudioSrc, SLDataSink *pAudioSnk,
+                                    SLuint32 numInterfaces, const SLInterfaceID *pInterfaceIds,
+                                    const SLboolean *pInterfaceRequired);
+    SLresult (*CreateOutputMix)(SLEngineItf self, SLObjectItf *pMix,
+                                SLuint32 numInterfaces, const SLInterfaceID *pInterfaceIds,
+                                const SLboolean *pInterfaceRequired);
+};
+
+struct SLPlayItf_;
+typedef const struct SLPlayItf_ *const *SLPlayItf;
+
+struct SLPlayItf_ {
+    SLresult (*SetPlayState)(SLPlayItf self, SLuint32 state);
+    SLresult (*GetPlayState)(SLPlayItf self, SLuint32 *pState);
+};
+
+struct SLSeekItf_;
+typedef const struct SLSeekItf_ *const *SLSeekItf;
+
+struct SLSeekItf_ {
+    SLresult (*SetLoop)(SLSeekItf self, SLboolean loopEnable,
+                        SLmillisecond startPos, SLmillisecond endPos);
+};
+
+struct SLRecordItf_;
+typedef const struct SLRecordItf_ *const *SLRecordItf;
+
+struct SLRecordItf_ {
+    SLresult (*SetRecordState)(SLRecordItf self, SLuint32 state);
+    SLresult (*SetCallbackEventsMask)(SLRecordItf self, SLuint32 eventFlags);
+};
+
+struct SLBufferQueueItf_;
+typedef const struct SLBufferQueueItf_ *const *SLBufferQueueItf;
+
+struct SLBufferQueueItf_ {
+    SLresult (*Enqueue)(SLBufferQueueItf self, const void *pBuffer, SLuint32 size);
+    SLresult (*Clear)(SLBufferQueueItf self);
+};
+
+SLresult slCreateEngine(SLObjectItf *pEngine, SLuint32 numOptions, const void *pEngineOptions,
+                        SLuint32 numInterfaces, const SLInterfaceID *pInterfaceIds,
+                        const SLboolean *pInterfaceRequired);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DROIDBLASTER_HOST_OPENSLES_H
@@ -0,0 +1,52 @@
+//
+// Created by cjf12 on 2019-11-02.
+//
+// Host stand-in for <SLES/OpenSLES_Android.h>.
+//
+
+#ifndef DROIDBLASTER_HOST_OPENSLES_ANDROID_H
+#define DROIDBLASTER_HOST_OPENSLES_ANDROID_H
+
+#include <SLES/OpenSLES.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SL_DATALOCATOR_ANDROIDFD                ((SLuint32) 0x800007BC)
+#define SL_DATALOCATOR_ANDROIDSIMPLEBUFFERQUEUE ((SLuint32) 0x800007BD)
+
+typedef int64_t SLAint64;
+
+typedef struct SLDataLocator_AndroidFD {
+    SLuint32 locatorType;
+    SLint32 fd;
+    SLAint64 offset;
+    SLAint64 length;
+} SLDataLocator_AndroidFD;
+
+extern const SLInterfaceID SL_IID_ANDROIDSIMPLEBUFFERQUEUE;
+
+typedef struct SLDataLocator_AndroidSimpleBufferQueue {
+    SLuint32 locatorType;
+    SLuint32 numBuffers;
+} SLDataLocator_AndroidSimpleBufferQueue;
+
+struct SLAndroidSimpleBufferQueueItf_;
+typedef const struct SLAndroidSimpleBufferQueueItf_ *const *SLAndroidSimpleBufferQueueItf;
+
+typedef void (*slAndroidSimpleBufferQueueCallback)(SLAndroidSimpleBufferQueueItf caller,
+                                                   void *pContext);
+
+struct SLAndroidSimpleBufferQueueItf_ {
+    SLresult (*Enqueue)(SLAndroidSimpleBufferQueueItf self, const void *pBuffer, SLuint32 size);
+    SLresult (*Clear)(SLAndroidSimpleBufferQueueItf self);
+    SLresult (*RegisterCallback)(SLAndroidSimpleBufferQueueItf self,
+                                 slAndroidSimpleBufferQueueCallback callback, void *pContext);
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DROIDBLASTER_HOST_OPENSLES_ANDROID_H
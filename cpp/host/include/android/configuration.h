@@ -0,0 +1,38 @@
+//
+// Created by cjf12 on 2019-11-02.
+//
+// Host stand-in for the NDK <android/configuration.h> and
+// <android/asset_manager.h>. Every getter reports "unknown" (0).
+//
+
+#ifndef DROIDBLASTER_HOST_ANDROID_CONFIGURATION_H
+#define DROIDBLASTER_HOST_ANDROID_CONFIGURATION_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct AAssetManager;
+typedef struct AAssetManager AAssetManager;
+
+struct AConfiguration;
+typedef struct AConfiguration AConfiguration;
+
+AConfiguration *AConfiguration_new();
+void AConfiguration_delete(AConfiguration *config);
+void AConfiguration_fromAssetManager(AConfiguration *out, AAssetManager *am);
+int32_t AConfiguration_getSdkVersion(AConfiguration *config);
+void AConfiguration_getLanguage(AConfiguration *config, char *outLanguage);
+void AConfiguration_getCountry(AConfiguration *config, char *outCountry);
+int32_t AConfiguration_getOrientation(AConfiguration *config);
+int32_t AConfiguration_getDensity(AConfiguration *config);
+int32_t AConfiguration_getScreenSize(AConfiguration *config);
+int32_t AConfiguration_getScreenLong(AConfiguration *config);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DROIDBLASTER_HOST_ANDROID_CONFIGURATION_H
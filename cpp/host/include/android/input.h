@@ -0,0 +1,64 @@
+//
+// Created by cjf12 on 2019-11-02.
+//
+// Host stand-in for the NDK <android/input.h> and <android/keycodes.h>.
+// Input events are never delivered on the host, accessors return zero.
+//
+
+#ifndef DROIDBLASTER_HOST_ANDROID_INPUT_H
+#define DROIDBLASTER_HOST_ANDROID_INPUT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct AInputEvent;
+typedef struct AInputEvent AInputEvent;
+
+struct AInputQueue;
+typedef struct AInputQueue AInputQueue;
+
+enum {
+    AINPUT_EVENT_TYPE_KEY = 1,
+    AINPUT_EVENT_TYPE_MOTION = 2
+};
+
+enum {
+    AINPUT_SOURCE_TOUCHSCREEN = 0x00001002,
+    AINPUT_SOURCE_TRACKBALL = 0x00010004
+};
+
+enum {
+    AKEY_EVENT_ACTION_DOWN = 0,
+    AKEY_EVENT_ACTION_UP = 1
+};
+
+enum {
+    AMOTION_EVENT_ACTION_DOWN = 0,
+    AMOTION_EVENT_ACTION_UP = 1,
+    AMOTION_EVENT_ACTION_MOVE = 2
+};
+
+enum {
+    AKEYCODE_DPAD_UP = 19,
+    AKEYCODE_DPAD_DOWN = 20,
+    AKEYCODE_DPAD_LEFT = 21,
+    AKEYCODE_DPAD_RIGHT = 22
+};
+
+int32_t AInputEvent_getType(const AInputEvent *event);
+int32_t AInputEvent_getSource(const AInputEvent *event);
+int32_t AKeyEvent_getAction(const AInputEvent *key_event);
+int32_t AKeyEvent_getKeyCode(const AInputEvent *key_event);
+int32_t AMotionEvent_getAction(const AInputEvent *motion_event);
+float AMotionEvent_getX(const AInputEvent *motion_event, size_t pointer_index);
+float AMotionEvent_getY(const AInputEvent *motion_event, size_t pointer_index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DROIDBLASTER_HOST_ANDROID_INPUT_H
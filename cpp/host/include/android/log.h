@@ -0,0 +1,35 @@
+//
+// Created by cjf12 on 2019-11-02.
+//
+// Host stand-in for the NDK <android/log.h>. Messages go to stderr.
+//
+
+#ifndef DROIDBLASTER_HOST_ANDROID_LOG_H
+#define DROIDBLASTER_HOST_ANDROID_LOG_H
+
+#include <stdarg.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum android_LogPriority {
+    ANDROID_LOG_UNKNOWN = 0,
+    ANDROID_LOG_DEFAULT,
+    ANDROID_LOG_VERBOSE,
+    ANDROID_LOG_DEBUG,
+    ANDROID_LOG_INFO,
+    ANDROID_LOG_WARN,
+    ANDROID_LOG_ERROR,
+    ANDROID_LOG_FATAL,
+    ANDROID_LOG_SILENT
+} android_LogPriority;
+
+int __android_log_print(int prio, const char *tag, const char *fmt, ...);
+int __android_log_vprint(int prio, const char *tag, const char *fmt, va_list ap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DROIDBLASTER_HOST_ANDROID_LOG_H
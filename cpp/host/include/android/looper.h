@@ -0,0 +1,34 @@
+//
+// Created by cjf12 on 2019-11-02.
+//
+// Host stand-in for the NDK <android/looper.h>. The host looper never has
+// pending events, so ALooper_pollAll() always times out.
+//
+
+#ifndef DROIDBLASTER_HOST_ANDROID_LOOPER_H
+#define DROIDBLASTER_HOST_ANDROID_LOOPER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct ALooper;
+typedef struct ALooper ALooper;
+
+typedef int (*ALooper_callbackFunc)(int fd, int events, void *data);
+
+enum {
+    ALOOPER_POLL_WAKE = -1,
+    ALOOPER_POLL_CALLBACK = -2,
+    ALOOPER_POLL_TIMEOUT = -3,
+    ALOOPER_POLL_ERROR = -4
+};
+
+int ALooper_pollOnce(int timeoutMillis, int *outFd, int *outEvents, void **outData);
+int ALooper_pollAll(int timeoutMillis, int *outFd, int *outEvents, void **outData);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DROIDBLASTER_HOST_ANDROID_LOOPER_H
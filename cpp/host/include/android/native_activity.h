@@ -0,0 +1,30 @@
+//
+// Created by cjf12 on 2019-11-02.
+//
+// Host stand-in for the NDK <android/native_activity.h>.
+//
+
+#ifndef DROIDBLASTER_HOST_ANDROID_NATIVE_ACTIVITY_H
+#define DROIDBLASTER_HOST_ANDROID_NATIVE_ACTIVITY_H
+
+#include <jni.h>
+#include <android/configuration.h>
+#include <android/input.h>
+#include <android/native_window.h>
+
+typedef struct ANativeActivity {
+    void *callbacks;
+    JavaVM *vm;
+    JNIEnv *env;
+    jobject clazz;
+    const char *internalDataPath;
+    const char *externalDataPath;
+    int32_t sdkVersion;
+    void *instance;
+    AAssetManager *assetManager;
+    const char *obbPath;
+} ANativeActivity;
+
+extern "C" void ANativeActivity_finish(ANativeActivity *activity);
+
+#endif //DROIDBLASTER_HOST_ANDROID_NATIVE_ACTIVITY_H
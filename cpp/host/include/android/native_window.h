@@ -0,0 +1,35 @@
+//
+// Created by cjf12 on 2019-11-02.
+//
+// Host stand-in for the NDK <android/native_window.h>.
+//
+
+#ifndef DROIDBLASTER_HOST_ANDROID_NATIVE_WINDOW_H
+#define DROIDBLASTER_HOST_ANDROID_NATIVE_WINDOW_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct ANativeWindow;
+typedef struct ANativeWindow ANativeWindow;
+
+typedef struct ANativeWindow_Buffer {
+    int32_t width;
+    int32_t height;
+    int32_t stride;
+    int32_t format;
+    void *bits;
+    uint32_t reserved[6];
+} ANativeWindow_Buffer;
+
+int32_t ANativeWindow_setBuffersGeometry(ANativeWindow *window,
+                                         int32_t width, int32_t height, int32_t format);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DROIDBLASTER_HOST_ANDROID_NATIVE_WINDOW_H
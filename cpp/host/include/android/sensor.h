@@ -0,0 +1,77 @@
+//
+// Created by cjf12 on 2019-11-02.
+//
+// Host stand-in for the NDK <android/sensor.h>. No sensor manager is
+// available on the host, so ASensorManager_getInstance() returns NULL.
+//
+
+#ifndef DROIDBLASTER_HOST_ANDROID_SENSOR_H
+#define DROIDBLASTER_HOST_ANDROID_SENSOR_H
+
+#include <stdint.h>
+#include <sys/types.h>
+#include <android/looper.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ASENSOR_STANDARD_GRAVITY (9.80665f)
+
+enum {
+    ASENSOR_TYPE_ACCELEROMETER = 1
+};
+
+typedef struct ASensorVector {
+    union {
+        float v[3];
+        struct {
+            float x;
+            float y;
+            float z;
+        };
+    };
+    int8_t status;
+    uint8_t reserved[3];
+} ASensorVector;
+
+typedef struct ASensorEvent {
+    int32_t version;
+    int32_t sensor;
+    int32_t type;
+    int32_t reserved0;
+    int64_t timestamp;
+    union {
+        float data[16];
+        ASensorVector vector;
+        ASensorVector acceleration;
+    };
+} ASensorEvent;
+
+struct ASensorManager;
+typedef struct ASensorManager ASensorManager;
+struct ASensorEventQueue;
+typedef struct ASensorEventQueue ASensorEventQueue;
+struct ASensor;
+typedef struct ASensor ASensor;
+typedef ASensor const *ASensorRef;
+
+ASensorManager *ASensorManager_getInstance();
+ASensor const *ASensorManager_getDefaultSensor(ASensorManager *manager, int type);
+ASensorEventQueue *ASensorManager_createEventQueue(ASensorManager *manager,
+                                                   ALooper *looper, int ident,
+                                                   ALooper_callbackFunc callback, void *data);
+int ASensorManager_destroyEventQueue(ASensorManager *manager, ASensorEventQueue *queue);
+int ASensorEventQueue_enableSensor(ASensorEventQueue *queue, ASensor const *sensor);
+int ASensorEventQueue_disableSensor(ASensorEventQueue *queue, ASensor const *sensor);
+int ASensorEventQueue_setEventRate(ASensorEventQueue *queue, ASensor const *sensor,
+                                   int32_t usec);
+ssize_t ASensorEventQueue_getEvents(ASensorEventQueue *queue, ASensorEvent *events,
+                                    size_t count);
+int ASensor_getMinDelay(ASensor const *sensor);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DROIDBLASTER_HOST_ANDROID_SENSOR_H
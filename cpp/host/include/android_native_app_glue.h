@@ -0,0 +1,69 @@
+//
+// Created by cjf12 on 2019-11-02.
+//
+// Host stand-in for the NDK native_app_glue. Only the android_app layout the
+// engine reads is provided; the host harness (see HostPlatform.h) fills it
+// in and drives the activity callbacks itself.
+//
+
+#ifndef DROIDBLASTER_HOST_ANDROID_NATIVE_APP_GLUE_H
+#define DROIDBLASTER_HOST_ANDROID_NATIVE_APP_GLUE_H
+
+#include <android/configuration.h>
+#include <android/input.h>
+#include <android/looper.h>
+#include <android/native_activity.h>
+#include <android/native_window.h>
+#include <android/sensor.h>
+
+struct android_app;
+
+struct android_poll_source {
+    int32_t id;
+    struct android_app *app;
+    void (*process)(struct android_app *app, struct android_poll_source *source);
+};
+
+struct android_app {
+    void *userData;
+    void (*onAppCmd)(struct android_app *app, int32_t cmd);
+    int32_t (*onInputEvent)(struct android_app *app, AInputEvent *event);
+    ANativeActivity *activity;
+    AConfiguration *config;
+    void *savedState;
+    size_t savedStateSize;
+    ALooper *looper;
+    AInputQueue *inputQueue;
+    ANativeWindow *window;
+    int activityState;
+    int destroyRequested;
+};
+
+enum {
+    LOOPER_ID_MAIN = 1,
+    LOOPER_ID_INPUT = 2,
+    LOOPER_ID_USER = 3
+};
+
+enum {
+    APP_CMD_INPUT_CHANGED,
+    APP_CMD_INIT_WINDOW,
+    APP_CMD_TERM_WINDOW,
+    APP_CMD_WINDOW_RESIZED,
+    APP_CMD_WINDOW_REDRAW_NEEDED,
+    APP_CMD_CONTENT_RECT_CHANGED,
+    APP_CMD_GAINED_FOCUS,
+    APP_CMD_LOST_FOCUS,
+    APP_CMD_CONFIG_CHANGED,
+    APP_CMD_LOW_MEMORY,
+    APP_CMD_START,
+    APP_CMD_RESUME,
+    APP_CMD_SAVE_STATE,
+    APP_CMD_PAUSE,
+    APP_CMD_STOP,
+    APP_CMD_DESTROY
+};
+
+extern "C" void app_dummy();
+
+#endif //DROIDBLASTER_HOST_ANDROID_NATIVE_APP_GLUE_H
@@ -0,0 +1,57 @@
+//
+// Created by cjf12 on 2019-11-02.
+//
+// Host stand-in for <jni.h>. There is no Java VM on the host:
+// AttachCurrentThread() fails, so JNI callers bail out before using JNIEnv.
+//
+
+#ifndef DROIDBLASTER_HOST_JNI_H
+#define DROIDBLASTER_HOST_JNI_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef int32_t jint;
+typedef void *jobject;
+typedef jobject jclass;
+typedef jobject jstring;
+typedef struct _jmethodID *jmethodID;
+typedef struct _jfieldID *jfieldID;
+
+#define JNI_OK           (0)
+#define JNI_ERR          (-1)
+#define JNI_VERSION_1_6  0x00010006
+
+struct JavaVMAttachArgs {
+    jint version;
+    const char *name;
+    jobject group;
+};
+
+struct _JNIEnv {
+    jclass GetObjectClass(jobject) { return NULL; }
+
+    jclass FindClass(const char *) { return NULL; }
+
+    jmethodID GetMethodID(jclass, const char *, const char *) { return NULL; }
+
+    jfieldID GetStaticFieldID(jclass, const char *, const char *) { return NULL; }
+
+    jobject GetStaticObjectField(jclass, jfieldID) { return NULL; }
+
+    jobject CallObjectMethod(jobject, jmethodID, ...) { return NULL; }
+
+    jint CallIntMethod(jobject, jmethodID, ...) { return 0; }
+
+    void DeleteLocalRef(jobject) {}
+};
+typedef _JNIEnv JNIEnv;
+
+struct _JavaVM {
+    jint AttachCurrentThread(JNIEnv **, void *) { return JNI_ERR; }
+
+    jint DetachCurrentThread() { return JNI_OK; }
+};
+typedef _JavaVM JavaVM;
+
+#endif //DROIDBLASTER_HOST_JNI_H
@@ -0,0 +1,85 @@
+//
+// Created by cjf12 on 2019-11-19.
+//
+
+#ifndef DROIDBLASTER_ASSETARCHIVE_H
+#define DROIDBLASTER_ASSETARCHIVE_H
+
+#include "Types.h"
+#include <stdint.h>
+#include <sys/types.h>
+
+// Packed asset archive: a header, an index sorted by path hash, the
+// NUL-terminated paths, then each blob aligned on ASSET_ARCHIVE_ALIGNMENT
+// in the order the packer was given. All integers are little-endian: the
+// packer writes and the runtime maps these structs as they are in memory,
+// so both only build for little-endian targets (all Android ABIs are).
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__)
+#error "Asset archives are only supported on little-endian targets"
+#endif
+#define ASSET_ARCHIVE_MAGIC 0x4b504244 // "DBPK"
+#define ASSET_ARCHIVE_VERSION 1
+#define ASSET_ARCHIVE_ALIGNMENT 16
+// Blob is a zlib stream which inflates to length bytes.
+#define ASSET_ARCHIVE_DEFLATED 0x1
+
+struct AssetArchiveHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+};
+
+struct AssetArchiveEntry {
+    uint64_t hash;
+    // Offsets are from the start of the archive.
+    uint64_t offset;
+    // Stored and decoded sizes, equal unless deflated.
+    uint64_t size;
+    uint64_t length;
+    uint32_t pathOffset;
+    uint32_t flags;
+};
+
+// Structs are mapped as is: no padding may differ between packer and game.
+static_assert(sizeof(AssetArchiveHeader) == 16, "Unexpected archive header layout");
+static_assert(sizeof(AssetArchiveEntry) == 40, "Unexpected archive entry layout");
+
+// Read-only view of an archive. The whole file is mapped once and its
+// descriptor is kept open so that stored entries can be streamed by
+// OpenSL ES. Lookups are thread-safe once open() has returned.
+class AssetArchive {
+public:
+    AssetArchive();
+    ~AssetArchive();
+
+    status open(const char *pPath);
+    void close();
+
+    bool isOpen() { return mBuffer != NULL; }
+
+    // Entry of an asset path, relative to the asset root, or NULL.
+    const AssetArchiveEntry *find(const char *pPath);
+
+    // Stored bytes of an entry, still deflated if flagged so.
+    const uint8_t *getData(const AssetArchiveEntry &pEntry) {
+        return mBuffer + pEntry.offset;
+    }
+
+    int32_t getDescriptor() { return mDescriptor; }
+
+    // 64 bits FNV-1a of a path, shared with the packer.
+    static uint64_t hashPath(const char *pPath);
+
+private:
+    AssetArchive(const AssetArchive &);
+    AssetArchive &operator=(const AssetArchive &);
+
+    int32_t mDescriptor;
+    const uint8_t *mBuffer;
+    off_t mLength;
+    const AssetArchiveEntry *mEntries;
+    uint32_t mEntryCount;
+};
+
+#endif //DROIDBLASTER_ASSETARCHIVE_H
@@ -0,0 +1,52 @@
+//
+// Created by cjf12 on 2019-11-05.
+//
+
+#ifndef DROIDBLASTER_BODYSTATES_H
+#define DROIDBLASTER_BODYSTATES_H
+
+#include "Types.h"
+#include <stdint.h>
+#include <vector>
+
+// Structure-of-arrays snapshot of every physics body, indexed by body slot.
+// PhysicsManager rewrites it after each world step; sprites bound to a body
+// read their position from it instead of being pushed a Location.
+// Collisions are reported separately, see ContactEventQueue.
+class BodyStates {
+public:
+    BodyStates();
+
+    int32_t add();
+
+    int32_t size() const { return int32_t(x.size()); }
+
+    // Blends the two last physics states into x/y:
+    // x = previousX + (currentX - previousX) * pAlpha.
+    void interpolate(float pAlpha);
+
+    // Positions in render units (pixels), contiguous per axis.
+    std::vector<float> x;
+    std::vector<float> y;
+
+    // Physics state before the last fixed step, only used in fixed time
+    // step mode.
+    std::vector<float> previousX;
+    std::vector<float> previousY;
+    // Physics state after the last step, in both modes.
+    std::vector<float> currentX;
+    std::vector<float> currentY;
+};
+
+// Box2D user data attached to every body and fixture loaded by
+// PhysicsManager. Only touched when a contact is reported or a body is
+// looked up, never by the per-frame passes.
+struct PhysicsCollision {
+    PhysicsCollision(int32_t pIndex) :
+            index(pIndex) {
+    }
+
+    int32_t index;
+};
+
+#endif //DROIDBLASTER_BODYSTATES_H
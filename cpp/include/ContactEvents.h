@@ -0,0 +1,78 @@
+//
+// Created by cjf12 on 2019-11-07.
+//
+
+#ifndef DROIDBLASTER_CONTACTEVENTS_H
+#define DROIDBLASTER_CONTACTEVENTS_H
+
+#include "Types.h"
+#include <algorithm>
+#include <stdint.h>
+#include <vector>
+
+// One contact reported by Box2D during a physics update. Bodies are
+// identified by their BodyStates slot; positions and speeds are in render
+// units (pixels, pixels per second).
+struct ContactEvent {
+    enum Type {
+        BEGIN, END
+    };
+
+    int32_t type;
+    int32_t bodyA;
+    int32_t bodyB;
+    uint16_t categoryA;
+    uint16_t categoryB;
+    // Closing speed along the contact normal when the contact began.
+    float approachSpeed;
+    float x;
+    float y;
+};
+
+// Fixed capacity list of the contacts of the current frame. Storage is
+// reserved once, appending never allocates: events past the capacity are
+// dropped and counted. Bodies whose BEGIN event was dropped are still
+// flagged, so that a hit is never missed.
+class ContactEventQueue {
+public:
+    ContactEventQueue(int32_t pCapacity);
+
+    void clear() {
+        //Flags are only ever set on overflow.
+        if (mDropped > 0) std::fill(mDroppedBodies.begin(), mDroppedBodies.end(), 0);
+        mCount = 0;
+        mDropped = 0;
+    }
+
+    // Returns the slot to fill in, or NULL when the queue is full.
+    ContactEvent *append() {
+        if (mCount == int32_t(mEvents.size())) {
+            ++mDropped;
+            return NULL;
+        }
+        return &mEvents[mCount++];
+    }
+
+    int32_t size() const { return mCount; }
+
+    int32_t getDropped() const { return mDropped; }
+
+    // Flags the bodies of a BEGIN event append() had no room for.
+    void markDropped(int32_t pBodyA, int32_t pBodyB);
+
+    // Whether a BEGIN event of pBody was dropped this frame.
+    bool isDropped(int32_t pBody) const {
+        return (mDropped > 0) && (pBody >= 0) && (pBody < int32_t(mDroppedBodies.size()))
+               && (mDroppedBodies[pBody] != 0);
+    }
+
+    const ContactEvent &operator[](int32_t pIndex) const { return mEvents[pIndex]; }
+
+private:
+    std::vector<ContactEvent> mEvents;
+    int32_t mCount;
+    int32_t mDropped;
+    std::vector<uint8_t> mDroppedBodies;
+};
+
+#endif //DROIDBLASTER_CONTACTEVENTS_H
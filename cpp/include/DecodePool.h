@@ -0,0 +1,66 @@
+//
+// Created by cjf12 on 2019-11-17.
+//
+
+#ifndef DROIDBLASTER_DECODEPOOL_H
+#define DROIDBLASTER_DECODEPOOL_H
+
+#include "ImageDecoder.h"
+#include "Resource.h"
+#include "Types.h"
+#include <deque>
+#include <pthread.h>
+#include <stdint.h>
+#include <vector>
+
+// Reads and decodes PNG resources on worker threads. Jobs are queued by
+// the GL thread, which collects decoded images with poll() and uploads
+// them. A resource must not be used elsewhere while its job is pending.
+class DecodePool {
+public:
+    struct Job {
+        Job() : resource(NULL), expandToRGBA(false), result(STATUS_KO), image() {}
+
+        Resource *resource;
+        bool expandToRGBA;
+        status result;
+        Image image;
+    };
+
+    DecodePool(int32_t pThreadCount);
+
+    ~DecodePool();
+
+    status start();
+
+    // Drops pending jobs and waits for the ones being decoded.
+    void stop();
+
+    void decode(Resource &pResource, bool pExpandToRGBA = false);
+
+    // Moves a finished job into pJob. Returns false when none is finished
+    // or, if pWait is set, when no job is left at all.
+    bool poll(Job &pJob, bool pWait = false);
+
+    int32_t getPendingCount();
+
+private:
+    static void *work(void *pPool);
+
+    bool takeJob(Job &pJob);
+
+    void finishJob(Job &pJob);
+
+    int32_t mThreadCount;
+    std::vector<pthread_t> mThreads;
+    pthread_mutex_t mMutex;
+    pthread_cond_t mJobAdded;
+    pthread_cond_t mJobFinished;
+    bool mRunning;
+    // Jobs queued, being decoded, and decoded but not polled yet.
+    std::deque<Job> mQueuedJobs;
+    int32_t mActiveJobCount;
+    std::deque<Job> mFinishedJobs;
+};
+
+#endif //DROIDBLASTER_DECODEPOOL_H
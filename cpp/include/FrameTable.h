@@ -0,0 +1,38 @@
+//
+// Created by cjf12 on 2019-11-15.
+//
+
+#ifndef DROIDBLASTER_FRAMETABLE_H
+#define DROIDBLASTER_FRAMETABLE_H
+
+#include <GLES2/gl2.h>
+#include <stdint.h>
+#include <vector>
+
+// Texture coordinates of every frame of a sprite sheet for a given frame
+// size, indexed by frame id. Built once per sheet and frame size by
+// GraphicsManager and shared by all sprites using them.
+struct FrameTable {
+    FrameTable() : id(0), frameCount(0), frameXCount(0), frameYCount(0),
+                   originU(0.0f), originV(0.0f), frameWidth(0.0f), frameHeight(0.0f),
+                   u(), v() {}
+
+    // pU1..pV2 is the sheet area in its texture (see TextureProperties).
+    void build(int32_t pSheetWidth, int32_t pSheetHeight,
+               GLfloat pU1, GLfloat pV1, GLfloat pU2, GLfloat pV2,
+               int32_t pFrameWidth, int32_t pFrameHeight);
+
+    // Creation rank in its GraphicsManager, to order sprites by table.
+    int32_t id;
+    int32_t frameCount;
+    // Frames per row and rows of frames.
+    int32_t frameXCount, frameYCount;
+    // Bottom-left corner of the sheet in its texture.
+    GLfloat originU, originV;
+    // Frame size in texture coordinates.
+    GLfloat frameWidth, frameHeight;
+    // Bottom-left corner of each frame.
+    std::vector<GLfloat> u, v;
+};
+
+#endif //DROIDBLASTER_FRAMETABLE_H
@@ -0,0 +1,50 @@
+//
+// Created by cjf12 on 2019-11-03.
+//
+
+#ifndef DROIDBLASTER_GAMESETTINGS_H
+#define DROIDBLASTER_GAMESETTINGS_H
+
+#include <stdint.h>
+
+// Scene population handed to DroidBlaster at construction. Defaults match
+// the shipped game; benchmarks scale them up.
+struct GameSettings {
+    GameSettings() :
+            asteroidCount(16),
+            starCount(50),
+            extraSpriteCount(0),
+            spriteHeadroom(64),
+            physicsFrequency(0.0f),
+            physicsMaxSubSteps(4),
+            kinematicAsteroids(false),
+            randomSeed(0),
+            textureAtlas(true),
+            instancedSprites(false),
+            imageCacheBudget(16 * 1024 * 1024) {
+    }
+
+    int32_t asteroidCount;
+    int32_t starCount;
+    // Purely decorative sprites (no physics body) added to the sprite batch.
+    int32_t extraSpriteCount;
+    // Sprite pool slots left for sprites registered while the game runs.
+    int32_t spriteHeadroom;
+    // Fixed physics step rate in Hz, 0 to step with the frame duration as
+    // the game always did.
+    float physicsFrequency;
+    // Upper bound of physics steps run in a single frame.
+    int32_t physicsMaxSubSteps;
+    // Moves asteroids outside of Box2D, with overlap detection only.
+    bool kinematicAsteroids;
+    // Seed of every random sequence, 0 to seed from the clock.
+    uint64_t randomSeed;
+    // Packs sprite sheets into shared textures.
+    bool textureAtlas;
+    // Expands sprite quads on the GPU from one record per sprite.
+    bool instancedSprites;
+    // Bytes of decoded images kept across GL context losses.
+    int64_t imageCacheBudget;
+};
+
+#endif //DROIDBLASTER_GAMESETTINGS_H
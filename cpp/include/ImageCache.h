@@ -0,0 +1,50 @@
+//
+// Created by cjf12 on 2019-11-18.
+//
+
+#ifndef DROIDBLASTER_IMAGECACHE_H
+#define DROIDBLASTER_IMAGECACHE_H
+
+#include "ImageDecoder.h"
+#include <list>
+#include <map>
+#include <stdint.h>
+#include <string>
+
+// Decoded images kept in memory, keyed by asset path, so that textures
+// lost with the GL context are uploaded again without decoding. Least
+// recently used images are evicted beyond a byte budget.
+class ImageCache {
+public:
+    ImageCache(int64_t pByteBudget);
+
+    void setByteBudget(int64_t pByteBudget);
+
+    int64_t getByteCount() { return mByteCount; }
+
+    // Cached image of a path, or NULL. Marks it as recently used. The
+    // pointer is valid until the next insert().
+    const Image *find(const std::string &pPath);
+
+    // Takes the pixels of pImage, which is left empty. Images larger than
+    // the whole budget are not kept.
+    void insert(const std::string &pPath, Image &pImage);
+
+    void clear();
+
+private:
+    struct Entry {
+        std::string path;
+        Image image;
+    };
+
+    void evict(int64_t pByteBudget);
+
+    int64_t mByteBudget;
+    int64_t mByteCount;
+    // Most recently used first.
+    std::list<Entry> mEntries;
+    std::map<std::string, std::list<Entry>::iterator> mIndex;
+};
+
+#endif //DROIDBLASTER_IMAGECACHE_H
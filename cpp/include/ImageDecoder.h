@@ -0,0 +1,100 @@
+//
+// Created by cjf12 on 2019-11-12.
+//
+
+#ifndef DROIDBLASTER_IMAGEDECODER_H
+#define DROIDBLASTER_IMAGEDECODER_H
+
+#include "Resource.h"
+#include "Types.h"
+#include <GLES2/gl2.h>
+#include <GLES2/gl2ext.h>
+#include <stdint.h>
+#include <vector>
+
+// Decoded pixels, 8 bits per channel. Rows are stored bottom-up, the
+// order OpenGL expects them in. Mip levels, if any, follow the full size
+// image, each half the size of the previous one down to 1 x 1.
+struct Image {
+    Image() : width(0), height(0), format(GL_RGBA), levelCount(1), pixels() {}
+
+    int32_t width;
+    int32_t height;
+    // GL_RGBA, GL_RGB, GL_LUMINANCE_ALPHA or GL_LUMINANCE.
+    GLint format;
+    int32_t levelCount;
+    std::vector<uint8_t> pixels;
+};
+
+// Pre-decoded texture written by droidblastertex: this header, then the
+// pixels of an Image as they are uploaded, in native byte order.
+#define RAW_TEXTURE_MAGIC 0x58544244 // "DBTX"
+#define RAW_TEXTURE_VERSION 1
+
+struct RawTextureHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t format;
+    uint32_t width;
+    uint32_t height;
+    uint32_t levelCount;
+    uint32_t reserved[2];
+};
+
+// ETC2 formats, core in GLES 3 only.
+#ifndef GL_COMPRESSED_RGB8_ETC2
+#define GL_COMPRESSED_RGB8_ETC2 0x9274
+#define GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2 0x9276
+#define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#endif
+
+#define MAX_COMPRESSED_LEVELS 16
+
+// ETC1 or ETC2 texture read from a KTX or PKM container, uploaded as is.
+// Levels point into the mapping of the resource. Blocks are not flipped:
+// like PNGs once decoded, textures must be encoded bottom row first.
+struct CompressedImage {
+    int32_t width;
+    int32_t height;
+    GLenum format;
+    int32_t levelCount;
+    const uint8_t *levels[MAX_COMPRESSED_LEVELS];
+    int32_t levelSizes[MAX_COMPRESSED_LEVELS];
+};
+
+class ImageDecoder {
+public:
+    // Decodes a PNG or loads a pre-decoded texture, whichever the
+    // resource contains. With pExpandToRGBA, the result is a single
+    // GL_RGBA level.
+    static status decode(Resource &pResource, Image &pImage, bool pExpandToRGBA = false);
+
+    // Reads the size of a PNG or pre-decoded texture from its header.
+    static status readSize(Resource &pResource, int32_t &pWidth, int32_t &pHeight);
+
+    // Decodes a PNG resource. With pExpandToRGBA, every color type is
+    // converted to GL_RGBA (opaque images get a full alpha channel).
+    static status decodePng(Resource &pResource, Image &pImage, bool pExpandToRGBA = false);
+
+    // Reads the size of a PNG resource from its header only.
+    static status readPngSize(Resource &pResource, int32_t &pWidth, int32_t &pHeight);
+
+    // Loads a pre-decoded texture. Pixels are copied as they are.
+    static status loadRawTexture(Resource &pResource, Image &pImage, bool pExpandToRGBA = false);
+
+    // Reads a KTX or PKM container. On success, the resource stays mapped
+    // until the caller is done with the levels and unmaps it.
+    static status readCompressed(Resource &pResource, CompressedImage &pImage);
+
+    // Bytes per pixel of an Image format.
+    static int32_t getPixelSize(GLint pFormat);
+
+    // Bytes of all the levels of an Image.
+    static int64_t getByteCount(int32_t pWidth, int32_t pHeight, GLint pFormat,
+                                int32_t pLevelCount);
+
+    // Number of levels of a full mip chain.
+    static int32_t getMaxLevelCount(int32_t pWidth, int32_t pHeight);
+};
+
+#endif //DROIDBLASTER_IMAGEDECODER_H
@@ -0,0 +1,106 @@
+//
+// Created by cjf12 on 2019-11-09.
+//
+
+#ifndef DROIDBLASTER_KINEMATICBODIES_H
+#define DROIDBLASTER_KINEMATICBODIES_H
+
+#include "ContactEvents.h"
+#include "Types.h"
+#include <stdint.h>
+#include <vector>
+
+// Circles moved at constant velocity outside of Box2D, for bodies that
+// only need overlap detection. Overlaps are found through a uniform
+// spatial hash rebuilt every step, against each other and against the
+// probes (the Box2D bodies) registered for that step, and reported to a
+// ContactEventQueue like Box2D contacts.
+// Positions, radii and velocities are in physics units.
+class KinematicBodies {
+public:
+    // pScale converts physics units to the render units of contact events.
+    KinematicBodies(float pScale);
+
+    // Area covered by the hash grid, which should include where bodies
+    // spawn. Bodies outside fall in the border cells: still detected, only
+    // more expensive.
+    void setBounds(float pLeft, float pBottom, float pRight, float pTop);
+
+    // Returns the kinematic body index; pSlot is its BodyStates slot.
+    int32_t add(int32_t pSlot, uint16_t pCategory, uint16_t pMask, float pRadius);
+
+    int32_t size() const { return int32_t(slot.size()); }
+
+    // Collides the next step against a Box2D body.
+    void addProbe(int32_t pSlot, uint16_t pCategory, uint16_t pMask, float pRadius,
+                  float pX, float pY, float pVelocityX, float pVelocityY);
+
+    // Categories and masks of all kinematic bodies, to filter probes.
+    uint16_t getCategories() const { return mCategories; }
+
+    uint16_t getMasks() const { return mMasks; }
+
+    // Moves bodies, then reports overlaps that started or ended since the
+    // previous step. Probes are consumed.
+    void step(float pTimeStep, ContactEventQueue &pContacts);
+
+    // Copies positions, in render units, into the slots of a state table.
+    void cachePositions(std::vector<float> &pX, std::vector<float> &pY) const;
+
+    std::vector<int32_t> slot;
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> velocityX;
+    std::vector<float> velocityY;
+    std::vector<float> radius;
+    std::vector<uint16_t> category;
+    std::vector<uint16_t> mask;
+
+private:
+    struct Probe {
+        int32_t slot;
+        uint16_t category;
+        uint16_t mask;
+        float radius;
+        float x, y;
+        float velocityX, velocityY;
+    };
+
+    // A pair of overlapping bodies, keyed by their slots (lowest first).
+    struct Overlap {
+        bool operator<(const Overlap &pOther) const { return key < pOther.key; }
+
+        uint64_t key;
+        ContactEvent event;
+    };
+
+    int32_t cellX(float pX) const;
+
+    int32_t cellY(float pY) const;
+
+    void buildGrid();
+
+    // Appends overlaps between a circle and the bodies of the grid, only
+    // considering kinematic bodies after pFirst.
+    void query(const Probe &pProbe, int32_t pFirst);
+
+    float mScale;
+    float mLeft, mBottom;
+    float mCellSize;
+    int32_t mColumns, mRows;
+    float mMaxRadius;
+    uint16_t mCategories;
+    uint16_t mMasks;
+
+    // Counting sort of bodies by cell: bodies of cell c are
+    // mCellBodies[mCellStart[c]..mCellStart[c + 1]).
+    std::vector<int32_t> mCellStart;
+    std::vector<int32_t> mCellCursor;
+    std::vector<int32_t> mCellBodies;
+
+    std::vector<Probe> mProbes;
+    std::vector<Overlap> mOverlaps;
+    std::vector<Overlap> mPreviousOverlaps;
+};
+
+#endif //DROIDBLASTER_KINEMATICBODIES_H
@@ -0,0 +1,49 @@
+//
+// Created by cjf12 on 2019-11-03.
+//
+
+#ifndef DROIDBLASTER_PROFILER_H
+#define DROIDBLASTER_PROFILER_H
+
+#include <stdint.h>
+
+// Per-stage wall time of the last DroidBlaster::onStep(). Stages are closed
+// with mark(), each one measuring the time elapsed since the previous mark.
+// Compiled out unless DROIDBLASTER_PROFILE is defined (host build).
+class Profiler {
+public:
+    enum Stage {
+        STAGE_TIME,
+        STAGE_PHYSICS,
+        STAGE_ASTEROIDS,
+        STAGE_MOVEABLE_BODY,
+        STAGE_SHIP,
+        STAGE_GRAPHICS,
+        STAGE_COUNT
+    };
+
+    static void begin();
+
+    static void mark(Stage pStage);
+
+    // Seconds spent in the stage during the last profiled frame.
+    static double getStageTime(Stage pStage);
+
+    static const char *getStageName(Stage pStage);
+
+private:
+    static double now();
+
+    static double sLastMark;
+    static double sStageTimes[STAGE_COUNT];
+};
+
+#ifdef DROIDBLASTER_PROFILE
+#define PROFILE_BEGIN() Profiler::begin()
+#define PROFILE_MARK(pStage) Profiler::mark(pStage)
+#else
+#define PROFILE_BEGIN()
+#define PROFILE_MARK(pStage)
+#endif
+
+#endif //DROIDBLASTER_PROFILER_H
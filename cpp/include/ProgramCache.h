@@ -0,0 +1,53 @@
+//
+// Created by cjf12 on 2019-11-21.
+//
+
+#ifndef DROIDBLASTER_PROGRAMCACHE_H
+#define DROIDBLASTER_PROGRAMCACHE_H
+
+#include <GLES2/gl2.h>
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// Linked program binaries, kept in memory for the whole process and saved
+// to a directory so that shaders are only compiled on the first run. Keys
+// hash the sources with the driver identity: binaries of another driver
+// version are never looked up.
+class ProgramCache {
+public:
+    struct Binary {
+        GLenum format;
+        std::vector<uint8_t> data;
+    };
+
+    ProgramCache();
+
+    // Where binaries are saved. Empty to keep them in memory only.
+    void setDirectory(const std::string &pDirectory);
+
+    // Vendor, renderer and version strings of the current driver.
+    void setDriver(const std::string &pDriver);
+
+    uint64_t getKey(const char *pVertexShader, const char *pFragmentShader);
+
+    // Binary of a key, from memory or else from disk, or NULL. The
+    // pointer is valid until the next insert() or remove().
+    const Binary *find(uint64_t pKey);
+
+    // Takes the data of pBinary, which is left empty.
+    void insert(uint64_t pKey, Binary &pBinary);
+
+    // Forgets a binary the driver rejected.
+    void remove(uint64_t pKey);
+
+private:
+    std::string getPath(uint64_t pKey);
+
+    std::string mDirectory;
+    uint64_t mDriverHash;
+    std::map<uint64_t, Binary> mBinaries;
+};
+
+#endif //DROIDBLASTER_PROGRAMCACHE_H
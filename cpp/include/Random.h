@@ -0,0 +1,43 @@
+//
+// Created by cjf12 on 2019-11-10.
+//
+
+#ifndef DROIDBLASTER_RANDOM_H
+#define DROIDBLASTER_RANDOM_H
+
+#include <stdint.h>
+
+// Seedable xoshiro128+ generator. Each subsystem owns one, so sequences are
+// reproducible from a seed and no state is shared between them. Streams
+// give independent sequences from the same seed.
+class Random {
+public:
+    Random(uint64_t pSeed, uint32_t pStream = 0);
+
+    void seed(uint64_t pSeed, uint32_t pStream = 0);
+
+    uint32_t next() {
+        const uint32_t result = mState[0] + mState[3];
+        const uint32_t t = mState[1] << 9;
+        mState[2] ^= mState[0];
+        mState[3] ^= mState[1];
+        mState[1] ^= mState[2];
+        mState[0] ^= mState[3];
+        mState[2] ^= t;
+        mState[3] = (mState[3] << 11) | (mState[3] >> 21);
+        return result;
+    }
+
+    // Uniform in [0, pMax). The 24 high bits fill the float mantissa.
+    float nextFloat(float pMax = 1.0f) {
+        return float(next() >> 8) * (pMax / 16777216.0f);
+    }
+
+    // Uniform in [pMin, pMax), pCount values at once.
+    void fill(float *pValues, int32_t pCount, float pMin, float pMax);
+
+private:
+    uint32_t mState[4];
+};
+
+#endif //DROIDBLASTER_RANDOM_H
@@ -0,0 +1,55 @@
+//
+// Created by cjf12 on 2019-11-14.
+//
+
+#ifndef DROIDBLASTER_SPRITEQUADS_H
+#define DROIDBLASTER_SPRITEQUADS_H
+
+#include <GLES2/gl2.h>
+#include <stdint.h>
+#include <vector>
+
+// Quads of a sprite batch in draw order, one entry per sprite, as a
+// structure of arrays. Sprites refresh their center, scale and frame each
+// frame; sizes only change when the batch is loaded. compactVisible()
+// keeps the quads on screen, then generateVertices() expands them all at
+// once, 4 per iteration with NEON or SSE, or generateInstances() packs one
+// record per quad for the GPU to expand.
+struct SpriteQuads {
+    void reserve(int32_t pCount);
+
+    void resize(int32_t pCount);
+
+    // Overwrites quad pTo with quad pFrom.
+    void copy(int32_t pFrom, int32_t pTo);
+
+    int32_t size() const { return int32_t(x.size()); }
+
+    // Copies quads overlapping the given rectangle to the first entries of
+    // pVisible, sized like this one, in order. pIndexes receives their
+    // index in this one. Returns the number of visible quads.
+    int32_t compactVisible(GLfloat pLeft, GLfloat pBottom, GLfloat pRight, GLfloat pTop,
+                           SpriteQuads &pVisible, std::vector<int32_t> &pIndexes) const;
+
+    // Writes 4 vertices (x, y, u, v) for each of the first pCount quads,
+    // in the order bottom-left, top-left, bottom-right, top-right.
+    void generateVertices(GLfloat *pVertices, int32_t pCount) const;
+
+    // Writes 1 instance (x, y, frame, scale) for each of the first pCount
+    // quads.
+    void generateInstances(GLfloat *pInstances, int32_t pCount) const;
+
+    // Updated every frame. Frame ids are stored as floats, exact up to
+    // 2^24, to be uploaded as is.
+    std::vector<GLfloat> x, y;
+    std::vector<GLfloat> u, v;
+    std::vector<GLfloat> frame, scale;
+
+    // Updated on load: bottom-left corner offset from the center, quad
+    // size and frame size in texture coordinates.
+    std::vector<GLfloat> offsetX, offsetY;
+    std::vector<GLfloat> width, height;
+    std::vector<GLfloat> frameWidth, frameHeight;
+};
+
+#endif //DROIDBLASTER_SPRITEQUADS_H
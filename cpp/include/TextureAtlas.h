@@ -0,0 +1,60 @@
+//
+// Created by cjf12 on 2019-11-12.
+//
+
+#ifndef DROIDBLASTER_TEXTUREATLAS_H
+#define DROIDBLASTER_TEXTUREATLAS_H
+
+#include "ImageDecoder.h"
+#include "Resource.h"
+#include "Types.h"
+#include <stdint.h>
+#include <vector>
+
+// Packs sprite sheets into a few large RGBA pages so that they can share a
+// texture. Sheets are placed on shelves, tallest first, and separated by
+// transparent padding. A sheet larger than a page is left out and loaded
+// on its own by GraphicsManager. Only sheet sizes are needed to lay pages
+// out: GraphicsManager copies pixels into the page textures as sheets get
+// decoded.
+class TextureAtlas {
+public:
+    // Where a sheet ended up, in pixels of its page.
+    struct Region {
+        int32_t page;
+        int32_t x, y;
+        int32_t width, height;
+    };
+
+    TextureAtlas(int32_t pMaxSize = 2048, int32_t pPadding = 2);
+
+    void addSheet(Resource &pResource);
+
+    // Sheet index of a resource, or -1 if not part of the atlas.
+    int32_t findSheet(Resource &pResource);
+
+    // Places the sheets, from their sizes in sheet order. Sheets given an
+    // empty size are left out.
+    status layout(const std::vector<Image> &pSizes);
+
+    int32_t getSheetCount() { return mSheets.size(); }
+
+    Resource &getSheet(int32_t pSheet) { return *mSheets[pSheet]; }
+
+    // Region of a sheet; page is -1 if it was left out.
+    const Region &getRegion(int32_t pSheet) { return mRegions[pSheet]; }
+
+    int32_t getPageCount() { return mPages.size(); }
+
+    // Page size and format, without pixels.
+    const Image &getPage(int32_t pPage) { return mPages[pPage]; }
+
+private:
+    int32_t mMaxSize;
+    int32_t mPadding;
+    std::vector<Resource *> mSheets;
+    std::vector<Region> mRegions;
+    std::vector<Image> mPages;
+};
+
+#endif //DROIDBLASTER_TEXTUREATLAS_H
@@ -0,0 +1,162 @@
+//
+// Created by cjf12 on 2019-11-19.
+//
+// Offline asset packer. Writes the files under ROOT to an archive read by
+// Resource, blobs in the order given so that assets loaded together are
+// read sequentially. Entries are deflated when it saves at least an
+// eighth of their size, unless --store is passed. Streamed audio is always
+// stored, as the player reads it in place from the archive file.
+//
+// Usage: droidblasterpack [--store] OUTPUT ROOT PATH...
+//        e.g. droidblasterpack droidblaster.pak ./ droidblaster/ship.png ...
+//
+
+#include "include/AssetArchive.h"
+
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <string>
+#include <vector>
+#include <zlib.h>
+
+struct PackedAsset {
+    std::string path;
+    std::vector<uint8_t> data;
+    AssetArchiveEntry entry;
+};
+
+static bool compareHash(const PackedAsset *pAsset1, const PackedAsset *pAsset2) {
+    return pAsset1->entry.hash < pAsset2->entry.hash;
+}
+
+static uint64_t align(uint64_t pOffset) {
+    return (pOffset + ASSET_ARCHIVE_ALIGNMENT - 1) & ~uint64_t(ASSET_ARCHIVE_ALIGNMENT - 1);
+}
+
+static bool readFile(const std::string &pPath, std::vector<uint8_t> &pData) {
+    FILE *file = fopen(pPath.c_str(), "rb");
+    if (file == NULL) return false;
+    bool result = (fseek(file, 0, SEEK_END) == 0);
+    long length = result ? ftell(file) : -1;
+    result = result && (length >= 0) && (fseek(file, 0, SEEK_SET) == 0);
+    if (result) {
+        pData.resize(length);
+        result = (length == 0) || (fread(&pData[0], length, 1, file) == 1);
+    }
+    fclose(file);
+    return result;
+}
+
+//Music played through a file descriptor, which needs the raw bytes.
+static bool isStreamed(const std::string &pPath) {
+    static const char *EXTENSIONS[] = {".mp3", ".ogg", ".wav", ".m4a", ".aac", ".mid"};
+    std::string::size_type extension = pPath.rfind('.');
+    if (extension == std::string::npos) return false;
+    for (size_t i = 0; i < sizeof(EXTENSIONS) / sizeof(EXTENSIONS[0]); ++i) {
+        if (strcasecmp(pPath.c_str() + extension, EXTENSIONS[i]) == 0) return true;
+    }
+    return false;
+}
+
+static bool deflateAsset(PackedAsset &pAsset) {
+    uLong length = pAsset.data.size();
+    uLongf size = compressBound(length);
+    std::vector<uint8_t> deflated(size);
+    if ((length == 0) || (compress2(&deflated[0], &size, &pAsset.data[0], length,
+                                    Z_BEST_COMPRESSION) != Z_OK)) return false;
+    if (size > length - (length / 8)) return false;
+    deflated.resize(size);
+    pAsset.data.swap(deflated);
+    pAsset.entry.size = size;
+    pAsset.entry.flags |= ASSET_ARCHIVE_DEFLATED;
+    return true;
+}
+
+int main(int pArgc, char **pArgv) {
+    int first = 1;
+    bool store = (pArgc > 1) && (strcmp(pArgv[1], "--store") == 0);
+    if (store) ++first;
+    if (pArgc - first < 3) {
+        fprintf(stderr, "Usage: %s [--store] OUTPUT ROOT PATH...\n", pArgv[0]);
+        return 1;
+    }
+    const char *output = pArgv[first];
+    std::string root = pArgv[first + 1];
+    if (!root.empty() && (root[root.size() - 1] != '/')) root += '/';
+
+    //Reads assets in layout order.
+    std::vector<PackedAsset> assets(pArgc - first - 2);
+    for (size_t i = 0; i < assets.size(); ++i) {
+        PackedAsset &asset = assets[i];
+        asset.path = pArgv[first + 2 + i];
+        if (!readFile(root + asset.path, asset.data)) {
+            fprintf(stderr, "Cannot read %s%s\n", root.c_str(), asset.path.c_str());
+            return 1;
+        }
+        memset(&asset.entry, 0, sizeof(asset.entry));
+        asset.entry.hash = AssetArchive::hashPath(asset.path.c_str());
+        asset.entry.size = asset.entry.length = asset.data.size();
+        if (!store && !isStreamed(asset.path)) deflateAsset(asset);
+    }
+
+    //Index sorted by hash, rejecting duplicated paths.
+    std::vector<PackedAsset *> index(assets.size());
+    for (size_t i = 0; i < assets.size(); ++i) index[i] = &assets[i];
+    std::stable_sort(index.begin(), index.end(), compareHash);
+    for (size_t i = 1; i < index.size(); ++i) {
+        if ((index[i - 1]->entry.hash == index[i]->entry.hash)
+            && (index[i - 1]->path == index[i]->path)) {
+            fprintf(stderr, "Duplicated asset %s\n", index[i]->path.c_str());
+            return 1;
+        }
+    }
+
+    //Paths follow the index, blobs follow the paths.
+    uint64_t offset = sizeof(AssetArchiveHeader) + assets.size() * sizeof(AssetArchiveEntry);
+    for (size_t i = 0; i < assets.size(); ++i) {
+        assets[i].entry.pathOffset = offset;
+        offset += assets[i].path.size() + 1;
+    }
+    for (size_t i = 0; i < assets.size(); ++i) {
+        offset = align(offset);
+        assets[i].entry.offset = offset;
+        offset += assets[i].entry.size;
+    }
+
+    FILE *file = fopen(output, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "Cannot write %s\n", output);
+        return 1;
+    }
+    AssetArchiveHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = ASSET_ARCHIVE_MAGIC;
+    header.version = ASSET_ARCHIVE_VERSION;
+    header.entryCount = assets.size();
+    bool result = (fwrite(&header, sizeof(header), 1, file) == 1);
+    for (size_t i = 0; i < index.size(); ++i) {
+        result = result && (fwrite(&index[i]->entry, sizeof(AssetArchiveEntry), 1, file) == 1);
+    }
+    for (size_t i = 0; i < assets.size(); ++i) {
+        result = result && (fwrite(assets[i].path.c_str(), assets[i].path.size() + 1, 1, file) == 1);
+    }
+    static const uint8_t padding[ASSET_ARCHIVE_ALIGNMENT] = {0};
+    for (size_t i = 0; i < assets.size(); ++i) {
+        const PackedAsset &asset = assets[i];
+        long padSize = asset.entry.offset - ftell(file);
+        result = result && (padSize >= 0) && (padSize < ASSET_ARCHIVE_ALIGNMENT)
+                 && ((padSize == 0) || (fwrite(padding, padSize, 1, file) == 1))
+                 && (asset.data.empty() || (fwrite(&asset.data[0], asset.data.size(), 1, file) == 1));
+        printf("%-32s %10llu -> %10llu%s\n", asset.path.c_str(),
+               (unsigned long long) asset.entry.length, (unsigned long long) asset.entry.size,
+               (asset.entry.flags & ASSET_ARCHIVE_DEFLATED) ? " deflated" : "");
+    }
+    result = (fclose(file) == 0) && result;
+    if (!result) {
+        fprintf(stderr, "Error writing %s\n", output);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+//
+// Created by cjf12 on 2019-11-20.
+//
+// Offline texture converter. Decodes a PNG with the engine's own decoder
+// and writes it as a pre-decoded texture, rows already flipped, which the
+// game uploads without running libpng. Installing the output at the PNG
+// asset path (loose or packed) is enough for the game to pick it up.
+// --mipmaps appends a box filtered mip chain, for power of two images
+// only as GLES 2 requires. --rgba expands the image to GL_RGBA first.
+//
+// Usage: droidblastertex [--mipmaps] [--rgba] INPUT OUTPUT
+//        INPUT is relative to the host asset root, as for any Resource.
+//
+
+#include "include/ImageDecoder.h"
+
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+
+//Averages each 2 x 2 block of the previous level, edges are clamped
+//when a side is already down to 1.
+static void appendLevel(Image &pImage, int32_t pLevel) {
+    int32_t pixelSize = ImageDecoder::getPixelSize(pImage.format);
+    int32_t width = std::max(pImage.width >> (pLevel - 1), 1);
+    int32_t height = std::max(pImage.height >> (pLevel - 1), 1);
+    int32_t levelWidth = std::max(width >> 1, 1);
+    int32_t levelHeight = std::max(height >> 1, 1);
+    size_t offset = ImageDecoder::getByteCount(pImage.width, pImage.height, pImage.format,
+                                               pLevel - 1);
+    size_t levelOffset = pImage.pixels.size();
+    pImage.pixels.resize(levelOffset + size_t(levelWidth) * levelHeight * pixelSize);
+
+    const uint8_t *source = &pImage.pixels[offset];
+    uint8_t *level = &pImage.pixels[levelOffset];
+    for (int32_t y = 0; y < levelHeight; ++y) {
+        int32_t y1 = std::min(y * 2, height - 1), y2 = std::min(y * 2 + 1, height - 1);
+        for (int32_t x = 0; x < levelWidth; ++x) {
+            int32_t x1 = std::min(x * 2, width - 1), x2 = std::min(x * 2 + 1, width - 1);
+            for (int32_t c = 0; c < pixelSize; ++c) {
+                int32_t sum = source[(y1 * width + x1) * pixelSize + c]
+                              + source[(y1 * width + x2) * pixelSize + c]
+                              + source[(y2 * width + x1) * pixelSize + c]
+                              + source[(y2 * width + x2) * pixelSize + c];
+                level[(y * levelWidth + x) * pixelSize + c] = uint8_t((sum + 2) / 4);
+            }
+        }
+    }
+}
+
+int main(int pArgc, char **pArgv) {
+    bool mipmaps = false, rgba = false;
+    int first = 1;
+    for (; first < pArgc; ++first) {
+        if (strcmp(pArgv[first], "--mipmaps") == 0) {
+            mipmaps = true;
+        } else if (strcmp(pArgv[first], "--rgba") == 0) {
+            rgba = true;
+        } else {
+            break;
+        }
+    }
+    if (pArgc - first != 2) {
+        fprintf(stderr, "Usage: %s [--mipmaps] [--rgba] INPUT OUTPUT\n", pArgv[0]);
+        return 1;
+    }
+
+    Resource resource(NULL, pArgv[first]);
+    Image image;
+    if (ImageDecoder::decodePng(resource, image, rgba) != STATUS_OK) {
+        fprintf(stderr, "Cannot decode %s\n", resource.getPath());
+        return 1;
+    }
+    if (mipmaps) {
+        if ((image.width & (image.width - 1)) || (image.height & (image.height - 1))) {
+            fprintf(stderr, "Mipmaps need a power of two image, not %d x %d\n",
+                    image.width, image.height);
+            return 1;
+        }
+        image.levelCount = ImageDecoder::getMaxLevelCount(image.width, image.height);
+        for (int32_t level = 1; level < image.levelCount; ++level) {
+            appendLevel(image, level);
+        }
+    }
+
+    RawTextureHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = RAW_TEXTURE_MAGIC;
+    header.version = RAW_TEXTURE_VERSION;
+    header.format = image.format;
+    header.width = image.width;
+    header.height = image.height;
+    header.levelCount = image.levelCount;
+
+    FILE *file = fopen(pArgv[first + 1], "wb");
+    if (file == NULL) {
+        fprintf(stderr, "Cannot write %s\n", pArgv[first + 1]);
+        return 1;
+    }
+    bool result = (fwrite(&header, sizeof(header), 1, file) == 1)
+                  && (fwrite(&image.pixels[0], image.pixels.size(), 1, file) == 1);
+    result = (fclose(file) == 0) && result;
+    if (!result) {
+        fprintf(stderr, "Error writing %s\n", pArgv[first + 1]);
+        return 1;
+    }
+    printf("%s: %d x %d, format 0x%04x, %d level(s), %zu bytes\n", pArgv[first + 1],
+           image.width, image.height, image.format, image.levelCount,
+           sizeof(header) + image.pixels.size());
+    return 0;
+}